@@ -443,7 +443,8 @@ void Brick :: CalcData()
 }
 
 
-void Brick :: Reduce (const BoxSphere<3> & box)
+void Brick :: CalcSurfaceActive (const BoxSphere<3> & box,
+                                NgFlatArray<int> active) const
 {
   double val;
   // Point<3> p;
@@ -463,7 +464,7 @@ void Brick :: Reduce (const BoxSphere<3> & box)
 	  else if (val < 0)  hasin = 1;
 	  if (hasout && hasin) break;
 	}
-      surfaceactive[i] =  hasout && hasin;
+      active[i] =  hasout && hasin;
     }
 }
 
@@ -507,21 +508,22 @@ INSOLID_TYPE OrthoBrick :: BoxInSolid (const BoxSphere<3> & box) const
 }
 
 
-void OrthoBrick :: Reduce (const BoxSphere<3> & box)
+void OrthoBrick :: CalcSurfaceActive (const BoxSphere<3> & box,
+                                     NgFlatArray<int> active) const
 {
-  surfaceactive.Elem(1) =
+  active.Elem(1) =
     (box.PMin()(2) < pmin(2)) && (pmin(2) < box.PMax()(2));
-  surfaceactive.Elem(2) =
+  active.Elem(2) =
     (box.PMin()(2) < pmax(2)) && (pmax(2) < box.PMax()(2));
 
-  surfaceactive.Elem(3) =
+  active.Elem(3) =
     (box.PMin()(1) < pmin(1)) && (pmin(1) < box.PMax()(1));
-  surfaceactive.Elem(4) =
+  active.Elem(4) =
     (box.PMin()(1) < pmax(1)) && (pmax(1) < box.PMax()(1));
 
-  surfaceactive.Elem(5) =
+  active.Elem(5) =
     (box.PMin()(0) < pmin(0)) && (pmin(0) < box.PMax()(0));
-  surfaceactive.Elem(6) =
+  active.Elem(6) =
     (box.PMin()(0) < pmax(0)) && (pmax(0) < box.PMax()(0));
 }
 
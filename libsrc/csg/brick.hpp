@@ -118,7 +118,8 @@ namespace netgen
     virtual void GetPrimitiveData (const char *& classname, NgArray<double> & coeffs) const;
     virtual void SetPrimitiveData (NgArray<double> & coeffs);
 
-    virtual void Reduce (const BoxSphere<3> & box);
+    virtual void CalcSurfaceActive (const BoxSphere<3> & box,
+                                    NgFlatArray<int> active) const;
     virtual void UnReduce ();
 
   protected:
@@ -142,7 +143,8 @@ namespace netgen
     }
 
     virtual INSOLID_TYPE BoxInSolid (const BoxSphere<3> & box) const;
-    virtual void Reduce (const BoxSphere<3> & box);
+    virtual void CalcSurfaceActive (const BoxSphere<3> & box,
+                                    NgFlatArray<int> active) const;
   };
 
 }
@@ -945,6 +945,17 @@ namespace netgen
 
   }
 
+  bool CSGeometry :: ThreadSafeSurfaces () const
+  {
+    // extrusion and revolution faces cache their last projection
+    for (int i = 0; i < GetNSurf(); i++)
+      if (dynamic_cast<const ExtrusionFace*> (GetSurface(i)) ||
+          dynamic_cast<const RevolutionFace*> (GetSurface(i)))
+        return false;
+    return true;
+  }
+
+
   void CSGeometry :: FindIdenticSurfaces (double eps)
   {
     int inv;
@@ -979,12 +990,7 @@ namespace netgen
 		     const BoxSphere<3> & box, 
 		     NgArray<int> & locsurf) const
   {
-    ReducePrimitiveIterator rpi(box);
-    UnReducePrimitiveIterator urpi;
-
-    const_cast<Solid*> (sol) -> IterateSolid (rpi);
-    sol -> GetSurfaceIndices (locsurf);
-    const_cast<Solid*> (sol) -> IterateSolid (urpi);
+    sol -> GetSurfaceIndices (box, locsurf);
 
     for (int i = locsurf.Size()-1; i >= 0; i--)
       {
@@ -1008,12 +1014,7 @@ namespace netgen
 				const BoxSphere<3> & box, 
 				NgArray<int> & locsurf) const
   {
-    ReducePrimitiveIterator rpi(box);
-    UnReducePrimitiveIterator urpi;
-
-    ((Solid*)sol) -> IterateSolid (rpi);
-    sol -> GetSurfaceIndices (locsurf);
-    ((Solid*)sol) -> IterateSolid (urpi);
+    sol -> GetSurfaceIndices (box, locsurf);
 
     for (int i = 0; i < locsurf.Size(); i++)
       locsurf[i] = isidenticto[locsurf[i]];
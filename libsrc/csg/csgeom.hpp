@@ -222,6 +222,8 @@ namespace netgen
     const Surface * GetSurface (const char * name) const;
     const Surface * GetSurface (int i) const
     { return surfaces[i]; }
+    /// surfaces can be evaluated from several threads
+    bool ThreadSafeSurfaces () const;
 
     void SetSolid (const char * name, Solid * sol);
     const Solid * GetSolid (const char * name) const;
@@ -165,6 +165,27 @@ namespace netgen
     for (int i = 0; i < specpoints.Size(); i++)
       specpoints[i].nr = i;
 
+    // Edges are followed in parallel in advance, from all unconditional
+    // points and from the points likely to be chosen next. The loop takes
+    // such a trace if the special points and mesh sizes it has seen are
+    // unchanged, otherwise it follows the edge again
+    NgArray<bool> removed(specpoints.Size());
+    removed = false;
+    Array<unique_ptr<EdgeTrace>> traces(specpoints.Size());
+
+    bool parallel = ngcore::task_manager && ngcore::TaskManager::GetNumThreads() > 1 &&
+      geometry.ThreadSafeSurfaces();
+    int nbatch = ngcore::TaskManager::GetNumThreads();
+
+    if (parallel)
+      {
+        NgArray<int> starts;
+        for (int i = 0; i < specpoints.Size(); i++)
+          if (specpoints[i].unconditional)
+            starts.Append (i);
+        FollowEdges (starts, hsp, h, mesh, traces);
+      }
+
     while (hsp.Size())
       {
 	SetThreadPercent(100 - 100 * double (hsp.Size()) / specpoints.Size());
@@ -289,12 +310,44 @@ namespace netgen
 		   << ", v = " << specpoints[hsp.Get(pi1)].v << endl;
 #endif
 
-	FollowEdge (pi1, ep, pos, hsp, h, mesh,
-		    edgepoints, curvelength);
+	if (parallel && !traces[hsp.Get(pi1)])
+	  {
+	    // a point taken from the end of hsp fills the gap of the
+	    // deleted start point, the next edges probably start there.
+	    // Points on the same pair of surfaces are often on the same edge
+	    NgArray<int> starts;
+	    NgArray<INDEX_2> surfpairs;
+	    int nhsp = hsp.Size();
+	    for (int i = 0; i <= min2 (nhsp, 4*nbatch) && starts.Size() < nbatch; i++)
+	      {
+		int spi = (i == 0) ? hsp.Get(pi1) : hsp.Get(nhsp+1-i);
+		INDEX_2 surfpair(specpoints[spi].s1, specpoints[spi].s2);
+		surfpair.Sort();
+		if (i > 0 && (traces[spi] || surfpairs.Contains (surfpair)))
+		  continue;
+		starts.Append (spi);
+		surfpairs.Append (surfpair);
+	      }
+	    FollowEdges (starts, hsp, h, mesh, traces);
+	  }
 
+	unique_ptr<EdgeTrace> trace = std::move(traces[hsp.Get(pi1)]);
+	if (!trace || !TraceUnchanged (*trace, removed, hsp, mesh))
+	  {
+	    trace = make_unique<EdgeTrace>();
+	    FollowEdge (hsp.Get(pi1), hsp, h, mesh, *trace);
+	  }
 
 	if (multithread.terminate)
 	  return;
+
+	edgepoints = trace->edgepoints;
+	curvelength = trace->curvelength;
+	pos = trace->pos;
+	ep = 0;
+	for (int i = 0; i < hsp.Size(); i++)
+	  if (hsp[i] == trace->endpoint)
+	    ep = i+1;
       
 	if (!ep)
 	  {
@@ -343,6 +396,8 @@ namespace netgen
 
 	searchtree -> DeleteElement (hsp.Get(ep));
 	searchtree -> DeleteElement (hsp.Get(pi1));
+	removed[hsp.Get(ep)] = true;
+	removed[hsp.Get(pi1)] = true;
 
 	if (ep > pi1)
 	  {
@@ -383,6 +438,7 @@ namespace netgen
 		     specpoints[locind[i]].unconditional == 0)
 		  {
 		    searchtree -> DeleteElement (locind[i]);
+		    removed[locind[i]] = true;
 
 		    int li = glob2hsp[locind[i]];
 		    glob2hsp[locind[i]] = -1;
@@ -700,12 +756,15 @@ namespace netgen
 
 
   void EdgeCalculation :: 
-  FollowEdge (int pi1, int & ep, int & pos,
-	      const NgArray<int> & hsp,
+  FollowEdge (int spi, const NgArray<int> & hsp,
 	      double h, const Mesh & mesh,
-	      NgArray<Point<3> > & edgepoints,
-	      NgArray<double> & curvelength)
+	      EdgeTrace & trace)
   {
+    int & pos = trace.pos;
+    NgArray<Point<3> > & edgepoints = trace.edgepoints;
+    NgArray<double> & curvelength = trace.curvelength;
+    int ep;
+
     int s1, s2, s1_rep, s2_rep;
     double len, steplen, cursteplen, loch;
     Point<3> p, np, pnp;
@@ -719,12 +778,12 @@ namespace netgen
     int uselocalh = mparam.uselocalh;
 
 
-    s1_rep = specpoints[hsp.Get(pi1)].s1;
-    s2_rep = specpoints[hsp.Get(pi1)].s2;
-    s1 = specpoints[hsp.Get(pi1)].s1_orig;
-    s2 = specpoints[hsp.Get(pi1)].s2_orig;
+    s1_rep = specpoints[spi].s1;
+    s2_rep = specpoints[spi].s2;
+    s1 = specpoints[spi].s1_orig;
+    s2 = specpoints[spi].s2_orig;
   
-    p = specpoints[hsp.Get(pi1)].p;
+    p = specpoints[spi].p;
     //ProjectToEdge (geometry.GetSurface(s1), 
     //               geometry.GetSurface(s2), p);
     geometry.GetSurface(s1) -> CalcGradient (p, a1);
@@ -733,7 +792,7 @@ namespace netgen
     t = Cross (a1, a2);
     t.Normalize();
 
-    pos = (specpoints[hsp.Get(pi1)].v * t) > 0;
+    pos = (specpoints[spi].v * t) > 0;
     if (!pos) t *= -1;
 
   
@@ -753,8 +812,11 @@ namespace netgen
       {
 	double lh = mesh.GetH(p);
 	// (*testout) << "lh " << lh << endl;
+	trace.hpoints.Append (p);
+	trace.hbounds.Append (loch);
 	if (lh < loch)
 	  loch = lh;
+	trace.hvalues.Append (loch);
       }
 
     steplen = 0.1 * loch;
@@ -767,6 +829,7 @@ namespace netgen
 	if (fabs (p(0)) + fabs (p(1)) + fabs (p(2)) > 100000*size)
 	  {
 	    ep = 0;
+	    trace.endpoint = -1;
 	    PrintWarning ("Give up line");
 	    break;
 	  }
@@ -808,11 +871,23 @@ namespace netgen
 	    double hvt = hv * t;
 	    hv -= hvt * t;
 
+	    bool unconditional = specpoints[locind[i]].unconditional == 1 ||
+	      trace.unconditional.Contains (locind[i]);
+
+	    // only such points can end the edge
+	    if (hv.Length() < 0.2 * cursteplen &&
+		hvt > 0 && hvt < 1.5 * cursteplen &&
+		(specpoints[locind[i]].v + t).Length() < 0.4)
+	      {
+		trace.touched.Append (locind[i]);
+		trace.touched_unconditional.Append (unconditional);
+	      }
+
 	    if (hv.Length() < 0.2 * cursteplen &&
 		hvt > 0 && 
 		//		  hvt < 1.5 * cursteplen &&
 		hvt < hvtmin && 
-		specpoints[locind[i]].unconditional == 1 &&
+		unconditional &&
 		(specpoints[locind[i]].v + t).Length() < 0.4  ) 
 	      {
 		Point<3> hep = specpoints[locind[i]].p;
@@ -834,7 +909,10 @@ namespace netgen
 
 			for (int jj = 0; jj < hsp.Size(); jj++)
 			  if (hsp[jj] == locind[i])
-			    ep = jj+1;
+			    {
+			      ep = jj+1;
+			      trace.endpoint = locind[i];
+			    }
 			    
 			if (!ep) 
 			  cerr << "endpoint not found" << endl;
@@ -901,7 +979,10 @@ namespace netgen
 	if (uselocalh)
 	  {
 	    double lh = mesh.GetH(np);
+	    trace.hpoints.Append (np);
+	    trace.hbounds.Append (loch);
 	    if (lh < loch) loch = lh;
+	    trace.hvalues.Append (loch);
 	  }
         
 	len += Dist (p, np) / loch;
@@ -920,6 +1001,72 @@ namespace netgen
   }
 
 
+  void EdgeCalculation :: 
+  FollowEdges (const NgArray<int> & starts, const NgArray<int> & hsp,
+	       double h, const Mesh & mesh,
+	       Array<unique_ptr<EdgeTrace>> & traces)
+  {
+    static Timer t("CSG: follow edges - parallel"); RegionTimer reg(t);
+
+    double eps = 1e-8*geometry.MaxSize();
+    ngcore::ParallelFor (Range(starts.Size()), [&] (size_t i)
+      {
+	if (multithread.terminate) return;
+
+	int spi = starts[i];
+	const SpecialPoint & sp = specpoints[spi];
+	auto trace = make_unique<EdgeTrace>();
+
+	if (!sp.unconditional)
+	  {
+	    // CalcEdges1 makes the start point and the points in
+	    // opposite direction unconditional
+	    trace->unconditional.Append (spi);
+	    Vec<3> boxrad(100*eps, 100*eps, 100*eps);
+	    NgArray<int> locind;
+	    searchtree -> GetIntersecting (sp.p - boxrad, sp.p + boxrad, locind);
+	    for (int j : locind)
+	      if (j != spi && Dist (sp.p, specpoints[j].p) < eps &&
+		  (sp.v + specpoints[j].v).Length() < 1e-4)
+		trace->unconditional.Append (j);
+	  }
+
+	FollowEdge (spi, hsp, h, mesh, *trace);
+	traces[spi] = std::move(trace);
+      });
+  }
+
+
+  bool EdgeCalculation :: 
+  TraceUnchanged (const EdgeTrace & trace,
+		  const NgArray<bool> & removed,
+		  const NgArray<int> & hsp,
+		  const Mesh & mesh) const
+  {
+    if (!hsp.Contains (trace.endpoint))
+      return false;
+
+    for (int i = 0; i < trace.touched.Size(); i++)
+      {
+	int spi = trace.touched[i];
+	if (removed[spi] ||
+	    (specpoints[spi].unconditional == 1) != trace.touched_unconditional[i])
+	  return false;
+      }
+
+    for (int i = 0; i < trace.hpoints.Size(); i++)
+      {
+	double loch = trace.hbounds[i];
+	double lh = mesh.GetH (trace.hpoints[i]);
+	if (lh < loch) loch = lh;
+	if (loch != trace.hvalues[i])
+	  return false;
+      }
+
+    return true;
+  }
+
+
 
 
 
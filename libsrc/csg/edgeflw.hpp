@@ -33,6 +33,26 @@ namespace netgen
 
 
 
+  /// an edge followed from a special point
+  struct EdgeTrace
+  {
+    /// special points taken as unconditional, in addition to the flag
+    NgArray<int> unconditional;
+    /// special point at the end of the edge, -1 if not found
+    int endpoint = -1;
+    int pos;
+    NgArray<Point<3> > edgepoints;
+    NgArray<double> curvelength;
+    /// special points which could have ended the edge, and the mesh size
+    /// evaluations (point, bound from the surfaces, resulting h).
+    /// The trace stays valid as long as these don't change
+    NgArray<int> touched;
+    NgArray<bool> touched_unconditional;
+    NgArray<Point<3> > hpoints;
+    NgArray<double> hbounds, hvalues;
+  };
+
+
   class EdgeCalculation
   {
     const CSGeometry & geometry;
@@ -60,12 +80,18 @@ namespace netgen
     void CalcEdges1 (double h, Mesh & mesh);
   
 
-    void FollowEdge (int pi1, int & ep, int & pos,
-		     // const NgArray<SpecialPoint> & hsp,
-		     const NgArray<int> & hsp,
+    void FollowEdge (int spi, const NgArray<int> & hsp,
 		     double h, const Mesh & mesh,
-		     NgArray<Point<3> > & edgepoints,
-		     NgArray<double> & curvelength);
+		     EdgeTrace & trace);
+
+    void FollowEdges (const NgArray<int> & starts, const NgArray<int> & hsp,
+		      double h, const Mesh & mesh,
+		      Array<unique_ptr<EdgeTrace>> & traces);
+
+    bool TraceUnchanged (const EdgeTrace & trace,
+			 const NgArray<bool> & removed,
+			 const NgArray<int> & hsp,
+			 const Mesh & mesh) const;
 		   
 
     void AnalyzeEdge (int s1, int s2, int s1_rep, int s2_rep, int pos, int layer,
@@ -913,10 +913,11 @@ namespace netgen
   }
 
 
-  void Extrusion :: Reduce (const BoxSphere<3> & box)
+  void Extrusion :: CalcSurfaceActive (const BoxSphere<3> & box,
+                                       NgFlatArray<int> active) const
   {
     for(int i = 0; i < faces.Size(); i++)
-      surfaceactive[i] = faces[i]->BoxIntersectsFace(box);
+      active[i] = faces[i]->BoxIntersectsFace(box);
   }
 
   void Extrusion :: UnReduce ()
@@ -176,7 +176,8 @@ namespace netgen
     const Surface & GetSurface (int i = 0) const override;
 
 
-    void Reduce (const BoxSphere<3> & box) override;
+    void CalcSurfaceActive (const BoxSphere<3> & box,
+                            NgFlatArray<int> active) const override;
     void UnReduce () override;
   };
 
@@ -22,7 +22,8 @@ namespace netgen
   static void FindPoints (CSGeometry & geom,
                           NgArray<SpecialPoint> &  specpoints,
                           NgArray<MeshPoint> & spoints,
-                          Mesh & mesh)
+                          Mesh & mesh,
+                          const MeshingParameters & mparam)
   {
     PrintMessage (1, "Start Findpoints");
 
@@ -48,7 +49,10 @@ namespace netgen
     spc.SetIdEps(geom.GetIdEps());
 
     if (spoints.Size() == 0)
-      spc.CalcSpecialPoints (geom, spoints);
+      {
+        RegionTaskManager rtm(mparam.parallel_meshing ? mparam.nthreads : 0);
+        spc.CalcSpecialPoints (geom, spoints);
+      }
     
     PrintMessage (2, "Analyze spec points");
     spc.AnalyzeSpecialPoints (geom, spoints, specpoints);
@@ -85,7 +89,10 @@ namespace netgen
   {
     EdgeCalculation ec (geom, specpoints, mparam);
     ec.SetIdEps(geom.GetIdEps());
-    ec.Calc (mparam.maxh, mesh);
+    {
+      RegionTaskManager rtm(mparam.parallel_meshing ? mparam.nthreads : 0);
+      ec.Calc (mparam.maxh, mesh);
+    }
 
     for (int i = 0; i < geom.singedges.Size(); i++)
       {
@@ -722,7 +729,7 @@ namespace netgen
 	  }
 
 	spoints.SetSize(0);
-	FindPoints (geom, specpoints, spoints, *mesh);
+	FindPoints (geom, specpoints, spoints, *mesh, mparam);
       
 	PrintMessage (5, "find points done");
 
@@ -757,14 +764,14 @@ namespace netgen
 	    mesh->CalcLocalH(mparam.grading);
 	    mesh->DeleteMesh();
 	    
-	    FindPoints (geom, specpoints, spoints, *mesh);
+	    FindPoints (geom, specpoints, spoints, *mesh, mparam);
 	    if (multithread.terminate) return TCL_OK;
 	    FindEdges (geom, *mesh, specpoints, spoints, mparam, true);
 	    if (multithread.terminate) return TCL_OK;
 	    
 	    mesh->DeleteMesh();
 	  
-	    FindPoints (geom, specpoints, spoints, *mesh);
+	    FindPoints (geom, specpoints, spoints, *mesh, mparam);
 	    if (multithread.terminate) return TCL_OK;
 	    FindEdges (geom, *mesh, specpoints, spoints, mparam);
 	    if (multithread.terminate) return TCL_OK;
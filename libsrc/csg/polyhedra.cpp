@@ -756,14 +756,15 @@ namespace netgen
     ;
   }
 
-  void Polyhedra :: Reduce (const BoxSphere<3> & box)
+  void Polyhedra :: CalcSurfaceActive (const BoxSphere<3> & box,
+                                       NgFlatArray<int> active) const
   {
     for (int i = 0; i < planes.Size(); i++)
-      surfaceactive[i] = 0;
+      active[i] = 0;
 
     for (int i = 0; i < faces.Size(); i++)
       if (FaceBoxIntersection (i, box))
-        surfaceactive[faces[i].planenr] = 1;
+        active[faces[i].planenr] = 1;
   }
 
   void Polyhedra :: UnReduce ()
@@ -103,7 +103,8 @@ namespace netgen
     virtual void GetPrimitiveData (const char *& classname, NgArray<double> & coeffs) const override;
     virtual void SetPrimitiveData (NgArray<double> & coeffs) override;
 
-    virtual void Reduce (const BoxSphere<3> & box) override;
+    virtual void CalcSurfaceActive (const BoxSphere<3> & box,
+                                    NgFlatArray<int> active) const override;
     virtual void UnReduce () override;
 
     int AddPoint (const Point<3> & p);
@@ -1029,11 +1029,12 @@ namespace netgen
   }
 
 
-  void Revolution :: Reduce (const BoxSphere<3> & box)
+  void Revolution :: CalcSurfaceActive (const BoxSphere<3> & box,
+                                        NgFlatArray<int> active) const
   { 
     //bool dummy;
     for(int i=0; i<faces.Size(); i++)
-      surfaceactive[i] = (faces[i]->BoxIntersectsFace(box));
+      active[i] = (faces[i]->BoxIntersectsFace(box));
     //surfaceactive[i] = (faces[i]->BoxIntersectsFace(box,dummy));
   }
 
@@ -168,7 +168,8 @@ namespace netgen
     virtual const Surface & GetSurface (int i = 0) const;
 
 
-    virtual void Reduce (const BoxSphere<3> & box);
+    virtual void CalcSurfaceActive (const BoxSphere<3> & box,
+                                    NgFlatArray<int> active) const;
     virtual void UnReduce ();
   
 	     
@@ -1622,6 +1622,46 @@ namespace netgen
 	}
       }
   }
+  void Solid :: GetSurfaceIndices (const BoxSphere<3> & box, NgArray<int> & surfind) const
+  {
+    surfind.SetSize (0);
+    RecGetSurfaceIndices (box, surfind);
+  }
+
+  void Solid :: RecGetSurfaceIndices (const BoxSphere<3> & box, NgArray<int> & surfind) const
+  {
+    switch (op)
+      {
+      case TERM: case TERM_REF:
+	{
+	  NgArrayMem<int,20> active(prim->GetNSurfaces());
+	  prim->CalcSurfaceActive (box, active);
+
+	  for (int j = 0; j < prim->GetNSurfaces(); j++)
+	    if (active[j])
+	      {
+		int siprim = prim->GetSurfaceId(j);
+		if (!surfind.Contains (siprim))
+		  surfind.Append (siprim);
+	      }
+	  break;
+	}
+      case UNION:
+      case SECTION:
+	{
+	  s1 -> RecGetSurfaceIndices (box, surfind);
+	  s2 -> RecGetSurfaceIndices (box, surfind);
+	  break;
+	}
+      case SUB:
+      case ROOT:
+	{
+	  s1 -> RecGetSurfaceIndices (box, surfind);
+	  break;
+	}
+      }
+  }
+
   void Solid :: ForEachSurface (const std::function<void(Surface*,bool)> & lambda, bool inv) const
   {
     switch (op)
@@ -105,6 +105,8 @@ namespace netgen
     int NumPrimitives () const;
     void GetSurfaceIndices (NgArray<int> & surfind) const;
     void GetSurfaceIndices (IndexSet & iset) const;
+    /// surfaces which can intersect the box, primitives are not reduced
+    void GetSurfaceIndices (const BoxSphere<3> & box, NgArray<int> & surfind) const;
 
     void GetTangentialSurfaceIndices (const Point<3> & p, NgArray<int> & surfids, double eps) const;
     void GetTangentialSurfaceIndices2 (const Point<3> & p, const Vec<3> & v, NgArray<int> & surfids, double eps) const;
@@ -242,6 +244,7 @@ namespace netgen
     void RecGetTangentialEdgeSurfaceIndices (const Point<3> & p, const Vec<3> & v, const Vec<3> & v2, const Vec<3> & m,
 					     NgArray<int> & surfids, double eps) const;
     void RecGetSurfaceIndices (IndexSet & iset) const;
+    void RecGetSurfaceIndices (const BoxSphere<3> & box, NgArray<int> & surfind) const;
 
     void RecCalcOnePrimitiveSpecialPoints (NgArray<Point<3> > & pts) const;
 
@@ -28,6 +28,17 @@ namespace netgen
 
   enum { check_crosspoint = 5 };
 
+  struct SpecialPointTask
+  {
+    unique_ptr<Solid> sol;
+    BoxSphere<3> box;
+    int level;
+    bool calccp, calcep;
+    // number of candidates found before this box
+    size_t pos;
+    NgArray<MeshPoint> points;
+  };
+
   SpecialPoint :: SpecialPoint (const SpecialPoint & sp)
   {
     p = sp.p;
@@ -103,6 +114,9 @@ namespace netgen
     // numprim_hist.SetSize (geometry->GetNSurf()+1);
     // numprim_hist = 0;
 
+    bool parallel = ngcore::task_manager && ngcore::TaskManager::GetNumThreads() > 1 &&
+      geometry->ThreadSafeSurfaces();
+
     for (int i = 0; i < geometry->GetNTopLevelObjects(); i++)
       {
 	const TopLevelObject * tlo = geometry->GetTopLevelObject(i);
@@ -120,8 +134,11 @@ namespace netgen
 	      AddPoint (hpts[j], tlo->GetLayer());
 	  }
 
-	CalcSpecialPointsRec (tlo->GetSolid(), tlo->GetLayer(),
-			      box, 1, 1, 1);
+	if (parallel)
+	  CalcSpecialPointsParallel (tlo->GetSolid(), tlo->GetLayer(), box);
+	else
+	  CalcSpecialPointsRec (tlo->GetSolid(), tlo->GetLayer(),
+				box, 1, 1, 1);
       }
  
   
@@ -171,6 +188,45 @@ namespace netgen
   
 
 
+  // The first levels of the box tree are searched serially, the sub-boxes
+  // of level parallel_level are searched in parallel. All points are
+  // collected as candidates and added in the order of the serial search,
+  // so the points and their numbering do not depend on the threads
+  void SpecialPointCalculation :: 
+  CalcSpecialPointsParallel (const Solid * sol, int layer,
+                             const BoxSphere<3> & box)
+  {
+    static Timer t("CSG: find special points - parallel"); RegionTimer reg(t);
+
+    NgArray<MeshPoint> cands;
+    Array<unique_ptr<SpecialPointTask>> subtasks;
+
+    SpecialPointCalculation top = *this;
+    top.candidates = &cands;
+    top.tasks = &subtasks;
+    top.CalcSpecialPointsRec (sol, layer, box, 1, 1, 1);
+
+    ngcore::ParallelFor (subtasks.Range(), [&] (size_t i)
+      {
+        SpecialPointTask & task = *subtasks[i];
+        SpecialPointCalculation sub = *this;
+        sub.candidates = &task.points;
+        sub.CalcSpecialPointsRec (task.sol.get(), layer, task.box,
+                                  task.level, task.calccp, task.calcep);
+      });
+
+    size_t j = 0;
+    for (size_t i = 0; i <= cands.Size(); i++)
+      {
+        for ( ; j < subtasks.Size() && subtasks[j]->pos == i; j++)
+          for (auto & p : subtasks[j]->points)
+            AddPoint (p, p.GetLayer());
+        if (i < cands.Size())
+          AddPoint (cands[i], cands[i].GetLayer());
+      }
+  }
+
+
   void SpecialPointCalculation :: 
   CalcSpecialPointsRec (const Solid * sol, int layer,
 			const BoxSphere<3> & box, 
@@ -643,7 +699,18 @@ namespace netgen
 	    sbox.CalcDiamCenter();
 	    Solid * redsol = sol -> GetReducedSolid (sbox);
 
-	    if (redsol)
+	    if (redsol && tasks && level+1 == parallel_level)
+	      {
+		auto task = make_unique<SpecialPointTask>();
+		task->sol = unique_ptr<Solid> (redsol);
+		task->box = sbox;
+		task->level = level+1;
+		task->calccp = calccp;
+		task->calcep = calcep;
+		task->pos = candidates->Size();
+		tasks->Append (std::move(task));
+	      }
+	    else if (redsol)
 	      {
 		CalcSpecialPointsRec (redsol, layer, sbox, level+1, calccp, calcep);
 		delete redsol;
@@ -1698,6 +1765,12 @@ namespace netgen
 
   bool SpecialPointCalculation :: AddPoint (const Point<3> & p, int layer)
   {
+    if (candidates)
+      {
+        candidates->Append (MeshPoint(p, layer));
+        return true;
+      }
+
     for (int i = 0; i < points->Size(); i++)
       if (Dist2 ( (*points)[i], p) < epspointdist2 &&
 	  (*points)[i].GetLayer() == layer)
@@ -72,6 +72,9 @@ namespace netgen
 
 
 
+  /// sub-box of the special point search, processed by one task
+  struct SpecialPointTask;
+
   ///
   class SpecialPointCalculation
   {
@@ -80,6 +83,12 @@ namespace netgen
     const CSGeometry * geometry;
     ///
     NgArray<MeshPoint> * points;
+    /// if set, points are collected here without removing duplicates
+    NgArray<MeshPoint> * candidates = nullptr;
+    /// if set, sub-boxes of level parallel_level are collected here
+    Array<unique_ptr<SpecialPointTask>> * tasks = nullptr;
+    /// box level at which the search is split into tasks
+    static constexpr int parallel_level = 3;
     ///
     NgArray<long int> boxesinlevel;
 
@@ -114,6 +123,9 @@ namespace netgen
 			       const BoxSphere<3> & box, 
 			       int level, 
 			       bool calccp, bool calcep);
+    ///
+    void CalcSpecialPointsParallel (const Solid * sol, int layer,
+                                    const BoxSphere<3> & box);
 
 
     ///
@@ -325,7 +325,16 @@ namespace netgen
     static Primitive * CreatePrimitive (const char * classname);
 
 
-    virtual void Reduce (const BoxSphere<3> & /* box */) { };
+    /// which surfaces can intersect the box, as Reduce would set them
+    virtual void CalcSurfaceActive (const BoxSphere<3> & /* box */,
+                                    NgFlatArray<int> active) const
+    {
+      for (int i = 0; i < active.Size(); i++)
+        active[i] = surfaceactive[i];
+    }
+
+    virtual void Reduce (const BoxSphere<3> & box)
+    { CalcSurfaceActive (box, surfaceactive); }
     virtual void UnReduce () { };
 
     virtual Primitive * Copy () const;
@@ -40,6 +40,88 @@ namespace GZSTREAM_NAMESPACE {
 // Internal classes to implement gzstream. See header file for user classes.
 // ----------------------------------------------------------------------------
 
+// --------------------------------------
+// gzip members with block size in the extra field
+// --------------------------------------
+
+namespace {
+    // id1 id2 cm flg(FEXTRA) mtime(4) xfl os xlen(2) si1 si2 slen(2) membersize(4)
+    const size_t memberHeaderSize = 20;
+    const unsigned char memberHeader[16] =
+        { 0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 255, 8, 0, 'N', 'G', 4, 0 };
+
+    void PutUInt32( char * p, uint32_t val) {
+        for (int i = 0; i < 4; i++)
+            p[i] = char((val >> (8*i)) & 0xff);
+    }
+
+    uint32_t GetUInt32( const char * p) {
+        uint32_t val = 0;
+        for (int i = 0; i < 4; i++)
+            val |= uint32_t(static_cast<unsigned char>(p[i])) << (8*i);
+        return val;
+    }
+
+    bool IsBlockedHeader( const char * p) {
+        return memcmp( p, memberHeader, 4) == 0 &&
+               memcmp( p+10, memberHeader+10, 6) == 0;
+    }
+
+    int NumBlocks() {
+        return ngcore::task_manager ? ngcore::TaskManager::GetNumThreads() : 1;
+    }
+
+    // compresses data into one complete gzip member
+    bool CompressMember( const std::string & data, std::string & member) {
+        z_stream zs;
+        zs.zalloc = Z_NULL;
+        zs.zfree = Z_NULL;
+        zs.opaque = Z_NULL;
+        if (deflateInit2( &zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return false;
+        member.resize( memberHeaderSize + deflateBound( &zs, data.size()) + 8);
+        zs.next_in = (Bytef*)data.data();
+        zs.avail_in = data.size();
+        zs.next_out = (Bytef*)&member[memberHeaderSize];
+        zs.avail_out = member.size() - memberHeaderSize;
+        int res = deflate( &zs, Z_FINISH);
+        size_t csize = zs.total_out;
+        deflateEnd( &zs);
+        if (res != Z_STREAM_END)
+            return false;
+
+        member.resize( memberHeaderSize + csize + 8);
+        memcpy( &member[0], memberHeader, 16);
+        PutUInt32( &member[16], member.size());
+        PutUInt32( &member[member.size()-8],
+                   crc32( 0, (const Bytef*)data.data(), data.size()));
+        PutUInt32( &member[member.size()-4], data.size());
+        return true;
+    }
+
+    // decompresses a gzip member written by CompressMember
+    bool DecompressMember( const std::string & member, std::string & data) {
+        if (member.size() < memberHeaderSize + 8)
+            return false;
+        data.resize( GetUInt32( &member[member.size()-4]));
+        z_stream zs;
+        zs.zalloc = Z_NULL;
+        zs.zfree = Z_NULL;
+        zs.opaque = Z_NULL;
+        zs.next_in = (Bytef*)&member[memberHeaderSize];
+        zs.avail_in = member.size() - memberHeaderSize - 8;
+        if (inflateInit2( &zs, -15) != Z_OK)
+            return false;
+        zs.next_out = (Bytef*)data.data();
+        zs.avail_out = data.size();
+        int res = inflate( &zs, Z_FINISH);
+        bool ok = res == Z_STREAM_END && zs.total_out == data.size();
+        inflateEnd( &zs);
+        return ok && crc32( 0, (const Bytef*)data.data(), data.size())
+            == GetUInt32( &member[member.size()-8]);
+    }
+}
+
 // --------------------------------------
 // class gzstreambuf:
 // --------------------------------------
@@ -52,6 +134,34 @@ namespace GZSTREAM_NAMESPACE {
     if ((mode & std::ios::ate) || (mode & std::ios::app)
         || ((mode & std::ios::in) && (mode & std::ios::out)))
         return (gzstreambuf*)0;
+
+    if ( mode & std::ios::out) {
+        blockfile.open( name, std::ios::out | std::ios::binary);
+        if ( ! blockfile.is_open())
+            return (gzstreambuf*)0;
+        blocked = true;
+        blocks.resize( NumBlocks());
+        nblocks = blocks.size();
+        current = 0;
+        blocks[0].resize( blockSize);
+        setp( &blocks[0][0], &blocks[0][0] + blockSize);
+        opened = 1;
+        return this;
+    }
+
+    if ( mode & std::ios::in) {
+        blockfile.open( name, std::ios::in | std::ios::binary);
+        char header[memberHeaderSize];
+        if ( blockfile.read( header, memberHeaderSize) && IsBlockedHeader( header)) {
+            blockfile.seekg( 0);
+            blocked = true;
+            nblocks = current = 0;
+            opened = 1;
+            return this;
+        }
+        blockfile.close();
+    }
+
     char  fmode[10];
     char* fmodeptr = fmode;
     if ( mode & std::ios::in)
@@ -75,18 +185,90 @@ gzstreambuf * gzstreambuf::close() {
     if ( is_open()) {
         sync();
         opened = 0;
+        if ( blocked) {
+            bool ok = true;
+            if ( mode & std::ios::out) {
+                blocks[current].resize( pptr() - pbase());
+                nblocks = current+1;
+                ok = write_blocks();
+            }
+            blocks.clear();
+            blockfile.close();
+            blocked = false;
+            return (ok && ! blockfile.fail()) ? this : (gzstreambuf*)0;
+        }
         if ( gzclose( file) == Z_OK)
             return this;
     }
     return (gzstreambuf*)0;
 }
 
+bool gzstreambuf::write_blocks() {
+    // compresses blocks[0..nblocks) in parallel and writes them in order
+    std::vector<std::string> members(nblocks);
+    std::atomic<bool> ok = true;
+    ngcore::ParallelFor( nblocks, [&] (size_t i) {
+        if ( ! CompressMember( blocks[i], members[i]))
+            ok = false;
+    });
+    for (auto & member : members)
+        blockfile.write( member.data(), member.size());
+    return ok && blockfile.good();
+}
+
+bool gzstreambuf::read_blocks() {
+    // reads the next batch of members and decompresses them in parallel
+    std::vector<std::string> members;
+    size_t nmax = NumBlocks();
+    char header[memberHeaderSize];
+    while (members.size() < nmax && blockfile.read( header, memberHeaderSize)) {
+        if ( ! IsBlockedHeader( header))
+            return false;
+        size_t size = GetUInt32( header+16);
+        if (size < memberHeaderSize + 8)
+            return false;
+        std::string member(size, '\0');
+        memcpy( &member[0], header, memberHeaderSize);
+        if ( ! blockfile.read( &member[memberHeaderSize], size-memberHeaderSize))
+            return false;
+        members.push_back( std::move(member));
+    }
+
+    nblocks = members.size();
+    if ( blocks.size() < nblocks)
+        blocks.resize( nblocks);
+    std::atomic<bool> ok = true;
+    ngcore::ParallelFor( nblocks, [&] (size_t i) {
+        if ( ! DecompressMember( members[i], blocks[i]))
+            ok = false;
+    });
+    current = 0;
+    return ok && nblocks > 0;
+}
+
 int gzstreambuf::underflow() { // used for input buffer only
     if ( gptr() && ( gptr() < egptr()))
         return * reinterpret_cast<unsigned char *>( gptr());
 
     if ( ! (mode & std::ios::in) || ! opened)
         return EOF;
+
+    if ( blocked) {
+        // next non-empty block, read new batch if necessary
+        current++;
+        while (true) {
+            while (current < nblocks && blocks[current].empty())
+                current++;
+            if (current < nblocks)
+                break;
+            if ( ! read_blocks())
+                return EOF;
+        }
+        char * data = &blocks[current][0];
+        setg( data, data, data + blocks[current].size());
+        return * reinterpret_cast<unsigned char *>( gptr());
+    }
+
     // Josuttis' implementation of inbuf
     int n_putback = gptr() - eback();
     if ( n_putback > 4)
@@ -119,6 +301,21 @@ int gzstreambuf::flush_buffer() {
 int gzstreambuf::overflow( int c) { // used for output buffer only
     if ( ! ( mode & std::ios::out) || ! opened)
         return EOF;
+    if ( blocked) {
+        // current block is full, compress batch when all blocks are full
+        if ( ++current == nblocks) {
+            if ( ! write_blocks())
+                return EOF;
+            current = 0;
+        }
+        blocks[current].resize( blockSize);
+        setp( &blocks[current][0], &blocks[current][0] + blockSize);
+        if (c != EOF) {
+            *pptr() = c;
+            pbump(1);
+        }
+        return c == EOF ? 0 : c;
+    }
     if (c != EOF) {
         *pptr() = c;
         pbump(1);
@@ -129,6 +326,10 @@ int gzstreambuf::overflow( int c) { // used for output buffer only
 }
 
 int gzstreambuf::sync() {
+    // in blocked mode data stays in the current block until it is full,
+    // otherwise every std::endl would start a new gzip member
+    if ( blocked)
+        return 0;
     // Changed to use flush_buffer() instead of overflow( EOF)
     // which caused improper behavior with std::endl and flush(),
     // bug reported by Vincent Ricard.
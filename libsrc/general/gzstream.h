@@ -32,6 +32,8 @@
 // standard C++ with new header file names and std:: namespace
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
 #include <zlib.h>
 
 #ifdef GZSTREAM_NAMESPACE
@@ -42,19 +44,34 @@ namespace GZSTREAM_NAMESPACE {
 // Internal classes to implement gzstream. See below for user classes.
 // ----------------------------------------------------------------------------
 
+// Output is compressed in blocks, each block is written as an independent
+// gzip member (readable by gunzip). The size of the member is stored in
+// the extra field of its header, which allows to read and decompress
+// such files in parallel. A batch of blocks is (de)compressed in parallel
+// by the TaskManager. Other gzip files are read through zlib's gzread.
+
 class gzstreambuf : public std::streambuf {
 private:
     static const int bufferSize = 47+256;    // size of data buff
     // totals 512 bytes under g++ for igzstream at the end.
+    static const size_t blockSize = 1 << 20; // uncompressed size of one member
 
     gzFile           file;               // file handle for compressed file
     char             buffer[bufferSize]; // data buffer
     char             opened;             // open/close state of stream
     int              mode;               // I/O mode
 
+    bool             blocked;            // file consists of netgen gzip members
+    std::fstream     blockfile;          // file handle in blocked mode
+    std::vector<std::string> blocks;     // uncompressed blocks of current batch
+    size_t           nblocks;            // number of used blocks
+    size_t           current;            // block in get/put area
+
     int flush_buffer();
+    bool write_blocks();
+    bool read_blocks();
 public:
-    gzstreambuf() : opened(0) {
+    gzstreambuf() : opened(0), blocked(false), nblocks(0), current(0) {
         setp( buffer, buffer + (bufferSize-1));
         setg( buffer + 4,     // beginning of putback area
               buffer + 4,     // read position
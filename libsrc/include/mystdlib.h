@@ -20,6 +20,7 @@
 #include <mutex>
 #include <atomic>
 #include <optional>
+#include <bitset>
 #include <cassert>
 
 #include <new>
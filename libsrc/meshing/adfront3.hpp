@@ -155,6 +155,15 @@ public:
       }
   }
   
+  /// face bounds the front, but is selected as base element only
+  /// after all other faces
+  void Freeze ()
+  { qualclass = 1000000; }
+
+  ///
+  bool Frozen () const
+  { return qualclass >= 1000000; }
+
   ///
   bool Valid () const
   { return !f.IsDeleted(); }
@@ -306,6 +315,14 @@ public:
   void ResetClass (INDEX fi)
   { faces[fi-1].ResetQualClass(); }
 
+  ///
+  void FreezeFace (INDEX fi)
+  { faces[fi-1].Freeze(); }
+
+  ///
+  bool FaceFrozen (INDEX fi) const
+  { return faces[fi-1].Frozen(); }
+
   ///
   void SetStartFront (int baseelnp = 0);
 
@@ -370,19 +370,19 @@ namespace netgen
         const char* savetask = multithread.task;
         multithread.task = "Analyse Edges";
 
-        // restrict meshsize on edges
-        for(auto i : Range(edges))
+        // restrict meshsize on edges, the edges are sampled in parallel
+        mesh.BeginRestrictLocalH();
+        ParallelFor(Range(edges), [&](auto i)
           {
-            multithread.percent = 100. * i/edges.Size();
             const auto & edge = edges[i];
             auto length = edge->GetLength();
             // skip very short edges
             if(length < mincurvelength)
-              continue;
+              return;
             static constexpr int npts = 20;
             // restrict mesh size based on edge length
-            for(auto i : Range(npts+1))
-              mesh.RestrictLocalH(edge->GetPoint(double(i)/npts), length/mparam.segmentsperedge);
+            for(auto j : Range(npts+1))
+              mesh.RestrictLocalHConcurrent(edge->GetPoint(double(j)/npts), length/mparam.segmentsperedge, i);
 
             // restrict mesh size based on edge curvature
             double t = 0.;
@@ -394,11 +394,12 @@ namespace netgen
                   {
                     auto p = edge->GetPoint(t);
                     auto dist = (p-p_old).Length();
-                    mesh.RestrictLocalH(p, dist);
+                    mesh.RestrictLocalHConcurrent(p, dist, i);
                     p_old = p;
                   }
               }
-          }
+          });
+        mesh.EndRestrictLocalH();
 
         multithread.task = "Analyse Faces";
         // restrict meshsize on faces
@@ -619,6 +620,44 @@ namespace netgen
     auto nedges = edges.Size();
     Array<Array<PointIndex>> all_pnums(nedges);
     Array<Array<double>> all_params(nedges);
+    Array<Array<Point<3>>> all_points(nedges);
+
+    // check if start and end vertex are identified (if so, we only insert one segment and do z-refinement later)
+    auto is_identified_edge = [&](const GeometryEdge & edge)
+    {
+        auto v0 = vertices[edge.GetStartVertex().nr].get();
+        auto v1 = vertices[edge.GetEndVertex().nr].get();
+        for(auto & ident : v0->identifications)
+        {
+            auto other = ident.from == v0 ? ident.to : ident.from;
+            if(other->nr == v1->nr && ident.type == Identifications::CLOSESURFACES)
+                return true;
+        }
+        return false;
+    };
+
+    // divide primary edges independently, points and segments are added to
+    // the mesh in edge order below, so numbering does not depend on the
+    // number of threads
+    {
+      static Timer tdiv("MeshEdges - divide"); RegionTimer rtdiv(tdiv);
+      RegionTaskManager rtm(mparam.parallel_meshing ? mparam.nthreads : 0);
+      ParallelFor(Range(edges), [&](auto edgenr)
+        {
+          auto edge = edges[edgenr].get();
+          if(edge->IsDegenerated() || edge->primary != edge)
+            return;
+          auto & params = all_params[edgenr];
+          if(is_identified_edge(*edge))
+            {
+              params.SetSize(2);
+              params[0] = 0.;
+              params[1] = 1.;
+            }
+          else
+            edge->Divide(mparam, mesh, all_points[edgenr], params);
+        });
+    }
 
     for (auto edgenr : Range(edges))
     {
@@ -635,37 +674,10 @@ namespace netgen
         // ----------- Add Points to mesh and create segments -----
         auto & pnums = all_pnums[edgenr];
         auto & params = all_params[edgenr];
-        Array<Point<3>> edge_points;
+        auto & edge_points = all_points[edgenr];
         Array<double> edge_params;
 
-        if(edge->primary == edge)
-        {
-            // check if start and end vertex are identified (if so, we only insert one segment and do z-refinement later)
-            bool is_identified_edge = false;
-            auto v0 = vertices[edge->GetStartVertex().nr].get();
-            auto v1 = vertices[edge->GetEndVertex().nr].get();
-            for(auto & ident : v0->identifications)
-            {
-                auto other = ident.from == v0 ? ident.to : ident.from;
-                if(other->nr == v1->nr && ident.type == Identifications::CLOSESURFACES)
-                {
-                    is_identified_edge = true;
-                    break;
-                }
-            }
-
-            if(is_identified_edge)
-            {
-                params.SetSize(2);
-                params[0] = 0.;
-                params[1] = 1.;
-            }
-            else
-            {
-                edge->Divide(mparam, mesh, edge_points, params);
-            }
-        }
-        else
+        if(edge->primary != edge)
         {
             auto nr_primary = edge->primary->nr;
             auto & pnums_primary = all_pnums[nr_primary];
@@ -846,6 +858,75 @@ namespace netgen
     return res != MESHING2_OK;
   }
 
+  static void MeshFacesParallel(const NetgenGeometry & geo, const Mesh & mesh,
+                                const MeshingParameters & mparam,
+                                FlatArray<unique_ptr<FaceMeshData>> face_data)
+  {
+    static Timer t("MeshFacesParallel"); RegionTimer regt(t);
+    auto faces = geo.Faces();
+
+    Array<int> face_nrs;
+    for(auto k : Range(faces))
+      if(faces[k]->primary == faces[k].get() && !faces[k]->IsConnectingCloseSurfaces())
+        face_nrs.Append(k);
+
+    if(face_nrs.Size() < 2)
+      return;
+
+    auto first_new_pi = mesh.Points().Range().Next();
+
+    RegionTaskManager rtm(mparam.nthreads);
+    ParallelFor(face_nrs.Range(), [&](auto i)
+      {
+        auto k = face_nrs[i];
+        const auto & face = *faces[k];
+        Mesh fmesh;
+        fmesh = mesh;
+
+        // face meshing refines the local h, so every face needs its own
+        // copy of the mesh-size tree (restricted to the face)
+        auto bb = face.GetBoundingBox();
+        bb.Increase(bb.Diam()/10);
+        auto & loch = mesh.GetLocalH();
+        if(loch)
+          fmesh.SetLocalH(loch->Copy(bb));
+        auto layer = face.properties.layer;
+        if(auto & loch_layer = mesh.GetLocalH(layer); loch_layer && loch_layer != loch)
+          fmesh.SetLocalH(loch_layer->Copy(bb), layer);
+
+        Array<int, PointIndex> glob2loc(fmesh.GetNP());
+        bool failed = geo.MeshFace(fmesh, mparam, k, glob2loc);
+
+        // edge mesh was compressed, mesh this face serially
+        if(fmesh.Points().Range().Next() < first_new_pi)
+          return;
+
+        auto data = make_unique<FaceMeshData>();
+        data->failed = failed;
+        for(auto pi : Range(first_new_pi, fmesh.Points().Range().Next()))
+          data->points.Append(fmesh[pi]);
+        for(auto sei : Range(mesh.GetNSE(), fmesh.GetNSE()))
+          data->elements.Append(fmesh.SurfaceElements()[sei]);
+        face_data[k] = std::move(data);
+      }, face_nrs.Size());
+  }
+
+  void MergeFaceMesh(Mesh & mesh, const FaceMeshData & data, PointIndex first_new_pi)
+  {
+    static Timer t("MergeFaceMesh"); RegionTimer rt(t);
+    Array<PointIndex> pmap(data.points.Size());
+    for(auto i : Range(data.points))
+      pmap[i] = mesh.AddPoint(data.points[i], data.points[i].GetLayer(), data.points[i].Type());
+
+    for(auto sel : data.elements)
+      {
+        for(auto & pi : sel.PNums())
+          if(pi >= first_new_pi)
+            pi = pmap[pi-first_new_pi];
+        mesh.AddSurfaceElement(sel);
+      }
+  }
+
   void NetgenGeometry :: MeshSurface(Mesh& mesh,
                                      const MeshingParameters& mparam) const
   {
@@ -854,8 +935,6 @@ namespace netgen
     multithread.task = "Mesh Surface";
     mesh.ClearFaceDescriptors();
 
-    size_t n_failed_faces = 0;
-    Array<int, PointIndex> glob2loc(mesh.GetNP());
     for(auto k : Range(faces))
     {
         auto & face = *faces[k];
@@ -864,6 +943,20 @@ namespace netgen
           fd.SetSurfColour(*face.properties.col);
         mesh.AddFaceDescriptor(fd);
         mesh.SetBCName(k, face.properties.GetName());
+    }
+
+    // mesh independent faces concurrently into copies of the edge mesh,
+    // they are merged in face order below, so numbering is the same as
+    // for serial meshing
+    Array<unique_ptr<FaceMeshData>> face_data(faces.Size());
+    if(mparam.parallel_meshing && mparam.parallel_surface_meshing)
+      MeshFacesParallel(*this, mesh, mparam, face_data);
+
+    size_t n_failed_faces = 0;
+    Array<int, PointIndex> glob2loc(mesh.GetNP());
+    for(auto k : Range(faces))
+    {
+        auto & face = *faces[k];
         if(face.primary == &face)
         {
             // check if this face connects two identified closesurfaces
@@ -975,6 +1068,13 @@ namespace netgen
                     }
                 }
             }
+            else if(face_data[k])
+            {
+                MergeFaceMesh(mesh, *face_data[k], glob2loc.Range().Next());
+                if(face_data[k]->failed)
+                    n_failed_faces++;
+                face_data[k].reset();
+            }
             else
                 if(MeshFace(mesh, mparam, k, glob2loc))
                     n_failed_faces++;
@@ -1224,6 +1324,8 @@ namespace netgen
 
     static Timer timer_opt2d("Optimization 2D");
     RegionTimer reg(timer_opt2d);
+    if (auto & loch = mesh.GetLocalH(); loch)
+      loch->Freeze();
     auto meshopt = MeshOptimize2d(mesh);
     for(auto i : Range(mparam.optsteps2d))
     for(auto k : Range(mesh.GetNFD()))
@@ -363,6 +363,17 @@ namespace netgen
   };
 
   DLL_HEADER GeometryRegisterArray& GeometryRegister();
+
+  // points and surface elements of a face meshed into a copy of the edge mesh
+  struct FaceMeshData
+  {
+    Array<MeshPoint> points;
+    Array<Element2d> elements;
+    bool failed = false;
+  };
+
+  // append face mesh data, points before first_new_pi are shared with the edge mesh
+  DLL_HEADER void MergeFaceMesh(Mesh & mesh, const FaceMeshData & data, PointIndex first_new_pi);
 }
 
 
@@ -94,7 +94,7 @@ namespace netgen
     }
 
     // get neighbour of element elnr in direction fnr 
-    int GetNB (int elnr, int fnr)
+    int GetNB (int elnr, int fnr) const
     { 
       return tets.Get(elnr).NB(fnr); 
     }
@@ -159,6 +159,12 @@ namespace netgen
       links.Elem(elnr) = elnr;
     }
 
+    // reserve links for elements up to nel
+    void SetSize (int nel)
+    {
+      links.SetSize (nel);
+    }
+
     void DeleteElement (int elnr)
     {
       links.Elem(elnr) = 0;
@@ -173,7 +179,7 @@ namespace netgen
     void GetList (int eli, NgArray<int> & linked) const;
 
     template <typename TFUNC>
-    void IterateList (int eli, TFUNC func)
+    void IterateList (int eli, TFUNC func) const
     {
       int pi = eli;
       do
@@ -217,21 +223,58 @@ namespace netgen
 
 
 
-  void AddDelaunayPoint (PointIndex newpi, const Point3d & newp, 
-			 NgArray<DelaunayTet> & tempels, 
-			 Mesh & mesh,
-			 DTREE & tettree,
-			 MeshNB & meshnb,
-			 NgArray<Point<3> > & centers, NgArray<double> & radi2,
-			 NgArray<int> & connected, NgArray<int> & treesearch, 
-			 NgArray<int> & freelist, SphereList & list,
-			 IndexSet & insphere, IndexSet & closesphere, Array<DelaunayTet> & newels)
+  /*
+    Visibility walk from tet elnr towards newp: step to the neighbour
+    behind a face separating the tet from newp.
+    Returns the tet containing newp, or -1 if the walk fails.
+  */
+  static int WalkToPoint (const Point<3> & newp, int elnr,
+                          const NgArray<DelaunayTet> & tempels, const Mesh & mesh)
+  {
+    for (int step = 0; step < 10000; step++)
+      {
+        const DelaunayTet & el = tempels.Get(elnr);
+        int next = -1;
+        for (int k = 0; k < 4; k++)
+          {
+            PointIndices<3> i3 = el.GetFace (k);
+            const Point<3> & p1 = mesh[i3[0]];
+            Vec<3> n = Cross (mesh[i3[1]]-p1, mesh[i3[2]]-p1);
+            double dist = n * (newp-p1);
+            if (n * (mesh[el[k]]-p1) > 0) dist *= -1;
+
+            if (dist > 1e-10 * n.Length())
+              {
+                next = el.NB(k);
+                break;
+              }
+          }
+
+        if (next == -1) return elnr;
+        if (next == 0) return -1;
+        elnr = next;
+      }
+    return -1;
+  }
+
+
+  /*
+    Find the tets whose circumsphere contains newp (the cavity of newp),
+    and tets with newp close to the sphere. Only reads the tetrahedralization.
+    Without search tree, newp is located by walking from tet hint.
+    Returns false if newp is in no sphere.
+  */
+  static bool FindDelaunayCavity (const Point<3> & newp, int hint,
+                                  const NgArray<DelaunayTet> & tempels,
+                                  const Mesh & mesh,
+                                  const DTREE * tettree,
+                                  const MeshNB & meshnb,
+                                  const NgArray<Point<3> > & centers, const NgArray<double> & radi2,
+                                  const SphereList & list,
+                                  IndexSet & insphere, IndexSet & closesphere)
   {
-    static Timer t("Meshing3::AddDelaunayPoint", NoTracing, NoTiming); RegionTimer reg(t);
     static Timer tsearch("addpoint, search", NoTracing, NoTiming);
     static Timer tfind("addpoint, find all tets", NoTracing, NoTiming);
-    static Timer tnewtets("addpoint, build new tets", NoTracing, NoTiming);
-    static Timer tinsert("addpoint, insert", NoTracing, NoTiming);
 
     /*
       find any sphere, such that newp is contained in
@@ -239,10 +282,6 @@ namespace netgen
     // DelaunayTet el;
     int cfelind = -1;
 
-    const Point<3> * pp[4];
-    Point<3> pc;
-    Point3d tpmin, tpmax;
-
 
 
     /*
@@ -273,8 +312,7 @@ namespace netgen
 
     tsearch.Start();
     double minquot{1e20};
-    tettree.GetFirstIntersecting
-      (newp, newp, [&](const auto pi)
+    auto test_sphere = [&](const auto pi)
        {
          double rad2 = radi2.Get(pi);
          double d2 = Dist2 (centers.Get(pi), newp); //  / radi2.Get(pi);
@@ -293,14 +331,25 @@ namespace netgen
 	    cfelind = pi;
           }
         return false;
-       } );
-    tsearch.Stop();
+       };
 
-    if (cfelind == -1)
+    if (tettree)
+      tettree->GetFirstIntersecting (newp, newp, test_sphere);
+    else
       {
-	PrintWarning ("Delaunay, point not in any sphere");
-	return;
+        int elnr = WalkToPoint (newp, hint, tempels, mesh);
+        if (elnr != -1 && Dist2 (centers.Get(elnr), newp) < radi2.Get(elnr))
+          cfelind = elnr;
+        else
+          // degenerate configuration, search all tets
+          for (int i = 1; i <= tempels.Size(); i++)
+            if (tempels.Get(i)[0].IsValid() && test_sphere(i))
+              break;
       }
+    tsearch.Stop();
+
+    if (cfelind == -1)
+      return false;
 	
     tfind.Start();
     /*
@@ -395,7 +444,16 @@ namespace netgen
       } // while (changed)
 
     tfind.Stop();
-    tnewtets.Start();
+    return true;
+  }
+
+
+  // new tets connecting the faces of the cavity with newpi
+  static void GetCavityTets (PointIndex newpi, const Point<3> & newp,
+                             const NgArray<DelaunayTet> & tempels,
+                             const Mesh & mesh, const MeshNB & meshnb,
+                             IndexSet & insphere, Array<DelaunayTet> & newels)
+  {
     newels.SetSize(0);
     
     Element2d face(TRIG);
@@ -443,6 +501,37 @@ namespace netgen
 #endif
 	    }
 	}
+  }
+
+
+  void AddDelaunayPoint (PointIndex newpi, const Point3d & newp, 
+			 NgArray<DelaunayTet> & tempels, 
+			 Mesh & mesh,
+			 DTREE * tettree,
+			 MeshNB & meshnb,
+			 NgArray<Point<3> > & centers, NgArray<double> & radi2,
+			 NgArray<int> & connected, NgArray<int> & treesearch, 
+			 NgArray<int> & freelist, SphereList & list,
+			 IndexSet & insphere, IndexSet & closesphere, Array<DelaunayTet> & newels,
+                         int & lastel)
+  {
+    static Timer t("Meshing3::AddDelaunayPoint", NoTracing, NoTiming); RegionTimer reg(t);
+    static Timer tnewtets("addpoint, build new tets", NoTracing, NoTiming);
+    static Timer tinsert("addpoint, insert", NoTracing, NoTiming);
+
+    const Point<3> * pp[4];
+    Point<3> pc;
+    Point3d tpmin, tpmax;
+
+    if (!FindDelaunayCavity (newp, lastel, tempels, mesh, tettree, meshnb, centers, radi2,
+                             list, insphere, closesphere))
+      {
+	PrintWarning ("Delaunay, point not in any sphere");
+	return;
+      }
+
+    tnewtets.Start();
+    GetCavityTets (newpi, newp, tempels, mesh, meshnb, insphere, newels);
 
     meshnb.ResetFaceHT (10*insphere.GetArray().Size()+1);
 
@@ -454,7 +543,8 @@ namespace netgen
 	for (int k = 0; k < 4; k++)
         tempels.Elem(celind)[k] = PointIndex::INVALID;
         
-        tettree.DeleteElement (celind);
+        if (tettree)
+          tettree->DeleteElement (celind);
 	freelist.Append (celind);
       }
 
@@ -542,6 +632,9 @@ namespace netgen
 	  }
 
 	closesphere.Add (nelind);
+        lastel = nelind;
+
+        if (!tettree) continue;
 	  
 	tpmax = tpmin = *pp[0];
 	for (int k = 1; k <= 3; k++)
@@ -551,7 +644,7 @@ namespace netgen
 	  }
 	tpmax = tpmax + 0.01 * (tpmax - tpmin);
         tinsert.Start();
-	tettree.Insert (tpmin, tpmax, nelind);
+	tettree->Insert (tpmin, tpmax, nelind);
         tinsert.Stop();
       }
       tnewtets.Stop();
@@ -562,6 +655,393 @@ namespace netgen
 
 
 
+  /*
+    Cavity of a point found in a batch, with the neighbour tets
+    which are updated when the cavity is filled.
+  */
+  struct DelaunayCavity
+  {
+    bool found;
+    Array<int> cavity;          // tets to delete
+    Array<int> shell;           // neighbours of the cavity
+    Array<int> close;           // neighbours with point close to the sphere
+    Array<DelaunayTet> newels;  // tets to add
+    Array<int> slots;           // element numbers of the new tets
+  };
+
+
+  /*
+    Replace the cavity by the new tets, like AddDelaunayPoint.
+    Writes only the cavity, the neighbour faces of the shell, the sphere
+    list of the close tets and the new slots, such that separated
+    cavities can be filled concurrently.
+    The search tree is updated by the caller.
+  */
+  static void FillDelaunayCavity (const Point<3> & newp, const DelaunayCavity & cav,
+                                  NgArray<DelaunayTet> & tempels, const Mesh & mesh,
+                                  MeshNB & meshnb,
+                                  NgArray<Point<3> > & centers, NgArray<double> & radi2,
+                                  SphereList & list, Array<int> & close)
+  {
+    meshnb.ResetFaceHT (10*cav.cavity.Size()+1);
+
+    for (int celind : cav.cavity)
+      {
+	meshnb.Delete (celind); 
+	list.DeleteElement (celind);
+	for (int k = 0; k < 4; k++)
+          tempels.Elem(celind)[k] = PointIndex::INVALID;
+      }
+
+    bool hasclose = false;
+    for (int ind : cav.close)
+      if (fabs (Dist2 (centers.Get (ind), newp) - radi2.Get(ind)) < 1e-8 )
+        hasclose = true;
+
+    close = cav.close;
+    for (size_t i = 0; i < cav.newels.Size(); i++)
+      {
+        int nelind = cav.slots[i];
+        const DelaunayTet & newel = cav.newels[i];
+        tempels.Elem(nelind) = newel;
+
+	meshnb.Add (nelind);
+	list.AddElement (nelind);
+
+        const Point<3> * pp[4];
+	for (int k = 0; k < 4; k++)
+	  pp[k] = &mesh.Point (newel[k]);
+
+        Point<3> pc;
+	CalcSphereCenter (&pp[0], pc);
+
+	double r2 = Dist2 (*pp[0], pc);
+	if (hasclose)
+          for (int csameind : close)
+            if (fabs (r2 - radi2.Get(csameind)) < 1e-10 && 
+                Dist2 (pc, centers.Get(csameind)) < 1e-20)
+              {
+                pc = centers.Get(csameind);
+                r2 = radi2.Get(csameind);
+                list.ConnectElement (nelind, csameind);
+                break;
+              }
+
+        centers.Elem(nelind) = pc;
+        radi2.Elem(nelind) = r2;
+        close.Append (nelind);
+      }
+  }
+
+
+  // position of p on a Hilbert curve through the box (Skilling's algorithm)
+  static uint64_t HilbertKey (const Point<3> & p, const Box<3> & box)
+  {
+    constexpr int bits = 20;
+    uint32_t x[3];
+    for (int k = 0; k < 3; k++)
+      {
+        double s = (p(k)-box.PMin()(k)) / (box.PMax()(k)-box.PMin()(k) + 1e-30);
+        x[k] = max2 (0, min2 (int(s * (1 << bits)), (1 << bits) - 1));
+      }
+
+    // coordinates to transposed Hilbert index
+    for (uint32_t q = 1u << (bits-1); q > 1; q >>= 1)
+      for (int i = 0; i < 3; i++)
+        if (x[i] & q)
+          x[0] ^= q-1;
+        else
+          {
+            uint32_t t = (x[0] ^ x[i]) & (q-1);
+            x[0] ^= t;
+            x[i] ^= t;
+          }
+
+    // Gray encode
+    for (int i = 1; i < 3; i++)
+      x[i] ^= x[i-1];
+    uint32_t t = 0;
+    for (uint32_t q = 1u << (bits-1); q > 1; q >>= 1)
+      if (x[2] & q)
+        t ^= q-1;
+    for (int i = 0; i < 3; i++)
+      x[i] ^= t;
+
+    uint64_t key = 0;
+    for (int b = bits-1; b >= 0; b--)
+      for (int i = 0; i < 3; i++)
+        key = (key << 1) | ((x[i] >> b) & 1);
+    return key;
+  }
+
+  static void SortAlongHilbertCurve (FlatArray<PointIndex> points, const Mesh & mesh,
+                                     const Box<3> & box)
+  {
+    Array<uint64_t> keys(points.Size());
+    Array<int> order(points.Size());
+    for (size_t i = 0; i < points.Size(); i++)
+      {
+        keys[i] = HilbertKey (mesh[points[i]], box);
+        order[i] = i;
+      }
+    QuickSortI (keys, order);
+
+    Array<PointIndex> sorted(points.Size());
+    for (size_t i = 0; i < points.Size(); i++)
+      sorted[i] = points[order[i]];
+    points = sorted;
+  }
+
+
+  /*
+    Bowyer-Watson insertion of points in batches: the cavities of a batch
+    are searched in parallel, then every point locks its cavity in batch
+    order. Points with separated cavities are inserted concurrently, the
+    others are retried in the next window.
+    Windows of the mixed point order are sorted along a space filling
+    curve, and a batch takes every n-th point of the window. So points of
+    a batch are spread over the domain, and consecutive batches are close.
+  */
+  static void AddDelaunayPointsBatched (FlatArray<PointIndex> points,
+                                        NgArray<DelaunayTet> & tempels, 
+                                        Mesh & mesh,
+                                        DTREE * tettree,
+                                        MeshNB & meshnb,
+                                        NgArray<Point<3> > & centers, NgArray<double> & radi2,
+                                        NgArray<int> & freelist, SphereList & list,
+                                        IndexSet & insphere, IndexSet & closesphere)
+  {
+    static Timer t("Meshing3::Delaunay1 - batched insertion"); RegionTimer reg(t);
+    static Timer tfind("Delaunay1 - find cavities");
+    static Timer tlock("Delaunay1 - lock cavities");
+    static Timer tfill("Delaunay1 - fill cavities");
+    static Timer ttree("Delaunay1 - update tree");
+
+    Array<DelaunayCavity> cavs;
+    Array<PointIndex> batch, retry;
+    Array<int> accepted, freed;
+    Array<int> hints;     // walk from tets of the previous batch
+    int lastel = 1;
+    Array<int> locked, lockedshell;    // batch number which locked the tet
+    NgArray<int> connected, treesearch;
+    Array<DelaunayTet> newels;
+
+    Box<3> box(Box<3>::EMPTY_BOX);
+    for (PointIndex pi : points)
+      box.Add (mesh[pi]);
+
+    Array<PointIndex> window;
+    size_t next = 0, nwbatches = 0, wnext = 0;
+    int nbatches = 0, nretry = 0;
+
+    while (next < points.Size() || wnext < nwbatches || retry.Size())
+      {
+        multithread.percent = 100.0 * next / points.Size();
+	if (multithread.terminate)
+	  break;
+
+        if (wnext == nwbatches)
+          {
+            // few tets: cavities overlap, insert serially
+            size_t batchsize = min2 (size_t(tempels.Size()) / 1024, size_t(4096));
+            if (batchsize < 16 && !retry.Size())
+              {
+                PointIndex pi = points[next++];
+                AddDelaunayPoint (pi, mesh[pi], tempels, mesh,
+                                  tettree, meshnb, centers, radi2, 
+                                  connected, treesearch, freelist, list, insphere, closesphere, newels,
+                                  lastel);
+                continue;
+              }
+
+            // next window: as many points as inserted so far, sorted along
+            // a space filling curve
+            window = retry;
+            retry.SetSize0();
+            size_t wsize = min2 (max2 (next, batchsize), points.Size()-next);
+            for (size_t i = 0; i < wsize; i++)
+              window.Append (points[next++]);
+
+            SortAlongHilbertCurve (window, mesh, box);
+
+            nwbatches = (window.Size() + batchsize-1) / batchsize;
+            wnext = 0;
+          }
+
+        // every nwbatches-th point of the window, conflicting points are
+        // retried in the next window
+        batch.SetSize0();
+        for (size_t i = wnext; i < window.Size(); i += nwbatches)
+          batch.Append (window[i]);
+        wnext++;
+        if (cavs.Size() < batch.Size())
+          cavs.SetSize (batch.Size());
+        while (hints.Size() < batch.Size())
+          hints.Append (lastel);
+        nbatches++;
+
+        tfind.Start();
+        ngcore::ParallelForRange (Range(batch), [&] (auto myrange)
+          {
+            IndexSet myinsphere(mesh.GetNP()), myclosesphere(mesh.GetNP());
+            for (auto j : myrange)
+              {
+                auto & cav = cavs[j];
+                const Point<3> & newp = mesh[batch[j]];
+                int hint = tempels.Get(hints[j])[0].IsValid() ? hints[j] : lastel;
+                cav.found = FindDelaunayCavity (newp, hint, tempels, mesh, tettree, meshnb,
+                                                centers, radi2, list, myinsphere, myclosesphere);
+                if (!cav.found) continue;
+
+                GetCavityTets (batch[j], newp, tempels, mesh, meshnb, myinsphere, cav.newels);
+
+                cav.cavity.SetSize0();
+                cav.shell.SetSize0();
+                for (int celind : myinsphere.GetArray())
+                  {
+                    cav.cavity.Append (celind);
+                    for (int k = 0; k < 4; k++)
+                      {
+                        int nbind = meshnb.GetNB (celind, k);
+                        if (nbind && !myinsphere.IsIn (nbind))
+                          cav.shell.Append (nbind);
+                      }
+                  }
+
+                cav.close.SetSize0();
+                for (int ind : myclosesphere.GetArray())
+                  if (!myinsphere.IsIn (ind))
+                    cav.close.Append (ind);
+              }
+          });
+        tfind.Stop();
+
+        /*
+          lock cavities in batch order, and give slots to the new tets.
+          A cavity stays valid if no other cavity touches it, so
+          cavities must not overlap other cavities or shells. Shells may
+          overlap, different faces of a shell tet are updated then.
+          Tets joining the sphere list are updated as well and locked
+          like the cavity.
+        */
+        tlock.Start();
+        if (locked.Size() < tempels.Size()+1)
+          {
+            size_t oldsize = locked.Size();
+            locked.SetSize (tempels.Size()+1);
+            locked.Range (oldsize, locked.Size()) = -1;
+            lockedshell.SetSize (tempels.Size()+1);
+            lockedshell.Range (oldsize, lockedshell.Size()) = -1;
+          }
+
+        int ntets = tempels.Size();
+        accepted.SetSize0();
+        freed.SetSize0();
+        for (size_t j = 0; j < batch.Size(); j++)
+          {
+            auto & cav = cavs[j];
+            if (!cav.found)
+              {
+                PrintWarning ("Delaunay, point not in any sphere");
+                continue;
+              }
+
+            bool conflict = false;
+            for (int el : cav.cavity)
+              if (locked[el] == nbatches || lockedshell[el] == nbatches)
+                conflict = true;
+            for (int el : cav.close)
+              if (locked[el] == nbatches || lockedshell[el] == nbatches)
+                conflict = true;
+            for (int el : cav.shell)
+              if (locked[el] == nbatches)
+                conflict = true;
+            if (conflict)
+              {
+                retry.Append (batch[j]);
+                nretry++;
+                continue;
+              }
+
+            for (int el : cav.cavity)
+              locked[el] = nbatches;
+            for (int el : cav.close)
+              locked[el] = nbatches;
+            for (int el : cav.shell)
+              lockedshell[el] = nbatches;
+            accepted.Append (j);
+
+            cav.slots.SetSize (cav.newels.Size());
+            for (size_t i = 0; i < cav.slots.Size(); i++)
+              if (i < cav.cavity.Size())
+                cav.slots[i] = cav.cavity[i];
+              else if (freelist.Size())
+                {
+                  cav.slots[i] = freelist.Last();
+                  freelist.DeleteLast();
+                }
+              else
+                cav.slots[i] = ++ntets;
+            for (size_t i = cav.slots.Size(); i < cav.cavity.Size(); i++)
+              freed.Append (cav.cavity[i]);
+          }
+
+        tempels.SetSize (ntets);
+        centers.SetSize (ntets);
+        radi2.SetSize (ntets);
+        list.SetSize (ntets);
+        tlock.Stop();
+
+        // the search tree is not used for filling, update it concurrently
+        tfill.Start();
+        ngcore::ParallelJob ([&] (TaskInfo & ti)
+          {
+            if (ti.task_nr == 0)
+              {
+                if (!tettree) return;
+                RegionTimer rt(ttree);
+                for (int j : accepted)
+                  for (int celind : cavs[j].cavity)
+                    tettree->DeleteElement (celind);
+
+                for (int j : accepted)
+                  for (size_t i = 0; i < cavs[j].slots.Size(); i++)
+                    {
+                      const DelaunayTet & el = cavs[j].newels[i];
+                      Point3d tpmin, tpmax;
+                      tpmax = tpmin = mesh.Point (el[0]);
+                      for (int k = 1; k <= 3; k++)
+                        {
+                          tpmin.SetToMin (mesh.Point (el[k]));
+                          tpmax.SetToMax (mesh.Point (el[k]));
+                        }
+                      tpmax = tpmax + 0.01 * (tpmax - tpmin);
+                      tettree->Insert (tpmin, tpmax, cavs[j].slots[i]);
+                    }
+                return;
+              }
+
+            MeshNB mymeshnb (tempels, 0);
+            Array<int> close;
+            for (auto i : Range(accepted).Split (ti.task_nr-1, ti.ntasks-1))
+              {
+                int j = accepted[i];
+                FillDelaunayCavity (mesh[batch[j]], cavs[j], tempels, mesh, mymeshnb,
+                                    centers, radi2, list, close);
+              }
+          }, TaskManager::GetNumThreads()+1);
+        tfill.Stop();
+
+        for (int el : freed)
+          freelist.Append (el);
+        for (int j : accepted)
+          hints[j] = lastel = cavs[j].slots[0];
+      }
+
+    PrintMessage (3, "Delaunay batches: ", nbatches, ", retried points: ", nretry);
+  }
+
+
   void Delaunay1 (Mesh & mesh, int domainnr, const MeshingParameters & mp, const AdFront3 & adfront,
 		  NgArray<DelaunayTet> & tempels,
 		  int oldnp, DelaunayTet & startel, Point3d & pmin, Point3d & pmax)
@@ -691,6 +1171,10 @@ namespace netgen
       // mixed[pi] = PointIndex ( (prim * pi) % np + PointIndex::BASE );
       mixed[pi] = (prim * (pi-IndexBASE<PointIndex>()+1)) % np + IndexBASE<PointIndex>() ;
 
+    // collect the points for batched insertion
+    bool batched = mp.parallel_meshing && mp.parallel_delaunay;
+    Array<PointIndex> batchpoints;
+
     Array<DelaunayTet> newels;
     // for (PointIndex pi = mesh.Points().Begin(); pi < mesh.Points().End()-4; pi++)
     for (PointIndex pi : mesh.Points().Range().Modify(0, -4))      
@@ -714,6 +1198,12 @@ namespace netgen
 
 	cntp++;
 
+        if (batched)
+          {
+            batchpoints.Append (newpi);
+            continue;
+          }
+
 	const MeshPoint & newp = mesh[newpi];
       
 	AddDelaunayPoint (newpi, newp, tempels, mesh,
@@ -721,6 +1211,10 @@ namespace netgen
 			  connected, treesearch, freelist, list, insphere, closesphere, newels);
 
       }
+
+    if (batched)
+      AddDelaunayPointsBatched (batchpoints, tempels, mesh, tettree, meshnb,
+                                centers, radi2, freelist, list, insphere, closesphere);
     
     for (int i = tempels.Size(); i >= 1; i--)
       if (!tempels.Get(i)[0].IsValid())
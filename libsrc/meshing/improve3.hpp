@@ -68,8 +68,10 @@ public:
 };
 
 
+// TPOINTS is Mesh::T_POINTS or PointCoordinates
+template <typename TPOINTS>
 inline double 
-CalcBad (const Mesh::T_POINTS & points, const Element & elem, double h, const MeshingParameters & mp)
+CalcBad (const TPOINTS & points, const Element & elem, double h, const MeshingParameters & mp)
 {
   if (elem.GetType() == TET)
     return CalcTetBadness (points[elem[0]], points[elem[1]],  
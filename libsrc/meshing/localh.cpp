@@ -180,16 +180,19 @@ namespace netgen
 
   void LocalH :: Delete ()
   {
+    flatboxes.SetSize0();
     root->DeleteChilds();
   }
 
   void LocalH :: DoArchive(Archive& ar)
   {
     ar & root & grading & boxes & boundingbox & dimension;
+    flatboxes.SetSize0();
   }
 
   void LocalH :: SetH (Point<3> p, double h)
   {
+    flatboxes.SetSize0();
     if (dimension == 2)
       {
         if (fabs (p(0) - root->xmid[0]) > root->h2 ||
@@ -336,9 +339,77 @@ namespace netgen
 
 
 
-  double LocalH :: GetH (Point<3> x) const
+  void LocalH :: GetH (FlatArray<Point<3>> x, FlatArray<double> h) const
   {
-    return Find(x)->HOpt();
+    ngcore::ParallelForRange (x.Range(), [&] (auto myrange)
+      {
+        for (auto i : myrange)
+          h[i] = GetH (x[i]);
+      });
+  }
+
+  void LocalH :: BeginConcurrentSetH ()
+  {
+    stagedh.SetSize (max2 (TaskManager::GetNumThreads(), 1));
+    for (auto & buffer : stagedh)
+      buffer.SetSize0();
+  }
+
+  void LocalH :: SetHConcurrent (Point<3> x, double h, size_t key)
+  {
+    size_t tid = TaskManager::GetThreadId();
+    if (tid >= stagedh.Size())
+      throw Exception ("LocalH::SetHConcurrent called outside of BeginConcurrentSetH or from a new thread");
+    auto & buffer = stagedh[tid];
+    buffer.Append (StagedH{ key, buffer.Size(), x, h });
+  }
+
+  void LocalH :: EndConcurrentSetH ()
+  {
+    static Timer t("LocalH::EndConcurrentSetH"); RegionTimer rt(t);
+    Array<StagedH> all;
+    for (auto & buffer : stagedh)
+      all.Append (buffer);
+    stagedh.SetSize0();
+
+    std::sort (all.begin(), all.end(), [] (const StagedH & a, const StagedH & b)
+               { return a.key < b.key || (a.key == b.key && a.nr < b.nr); });
+    for (auto & r : all)
+      SetH (r.p, r.h);
+  }
+
+  void LocalH :: Freeze ()
+  {
+    static Timer t("LocalH::Freeze"); RegionTimer rt(t);
+
+    // children of a box are appended in child order, so they are
+    // consecutive in the breadth-first order
+    Array<GradingBox*> order(boxes.Size());
+    order.SetSize0();
+    order.Append (root);
+    for (size_t i = 0; i < order.Size(); i++)
+      for (auto child : order[i]->childs)
+        if (child)
+          order.Append (child);
+
+    flatboxes.SetSize (order.Size());
+    int next = 1;
+    for (auto i : Range(order))
+      {
+        const GradingBox & box = *order[i];
+        FlatBox & fbox = flatboxes[i];
+        for (int j = 0; j < 3; j++)
+          fbox.xmid[j] = box.xmid[j];
+        fbox.hopt = box.hopt;
+        fbox.childmask = 0;
+        fbox.firstchild = next;
+        for (int j = 0; j < 8; j++)
+          if (box.childs[j])
+            {
+              fbox.childmask |= 1 << j;
+              next++;
+            }
+      }
   }
 
 
@@ -885,6 +956,7 @@ namespace netgen
 
   void LocalH :: Convexify ()
   {
+    flatboxes.SetSize0();
     ConvexifyRec (root);
   }
 
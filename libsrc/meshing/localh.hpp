@@ -88,6 +88,30 @@ namespace netgen
     Box<3> boundingbox;
     /// octree or quadtree
     int dimension;
+
+    /// node of the frozen tree
+    struct FlatBox
+    {
+      float xmid[3];
+      /// bit i is set if child i exists
+      uint8_t childmask;
+      /// existing children are stored consecutively from here
+      int firstchild;
+      double hopt;
+    };
+    /// read-only copy of the tree in breadth-first (and per level
+    /// Morton) order, empty if the tree is not frozen
+    Array<FlatBox> flatboxes;
+
+    /// restriction collected by SetHConcurrent
+    struct StagedH
+    {
+      size_t key, nr;
+      Point<3> p;
+      double h;
+    };
+    /// one buffer per thread, between Begin- and EndConcurrentSetH
+    Array<Array<StagedH>> stagedh;
   public:
     ///
     DLL_HEADER LocalH (Point<3> pmin, Point<3> pmax, double grading, int adimension = 3);
@@ -110,7 +134,30 @@ namespace netgen
     ///
     DLL_HEADER void SetH (Point<3> x, double h);
     ///
-    DLL_HEADER double GetH (Point<3> x) const;
+    DLL_HEADER double GetH (Point<3> x) const
+    {
+      if (flatboxes.Size())
+        return FindFlat(x).hopt;
+      return Find(x)->HOpt();
+    }
+    /// h at many points, in parallel
+    DLL_HEADER void GetH (FlatArray<Point<3>> x, FlatArray<double> h) const;
+
+    /// start collecting restrictions from several threads. Call it
+    /// after the task manager is started
+    DLL_HEADER void BeginConcurrentSetH ();
+    /// thread-safe SetH, the restriction is applied by EndConcurrentSetH.
+    /// key is the position in a serial loop, restrictions with the same
+    /// key must come from one thread
+    DLL_HEADER void SetHConcurrent (Point<3> x, double h, size_t key);
+    /// apply the collected restrictions ordered by key, as serial SetH
+    /// calls in that order would
+    DLL_HEADER void EndConcurrentSetH ();
+
+    /// build a compact copy of the tree which is used by GetH. Any
+    /// modification drops it, call again after the last SetH
+    DLL_HEADER void Freeze ();
+    bool IsFrozen () const { return flatboxes.Size() > 0; }
     /// minimal h in box (pmin, pmax)
     DLL_HEADER double GetMinH (Point<3> pmin, Point<3> pmax) const;
 
@@ -121,7 +168,7 @@ namespace netgen
     void CutBoundary (const Box<3> & box)
     { CutBoundaryRec (box.PMin(), box.PMax(), root); }
 
-    GradingBox * Find(Point<3> p) const;
+    DLL_HEADER GradingBox * Find(Point<3> p) const;
   
     /// find inner boxes
     void FindInnerBoxes (const class AdFront3 & adfront,
@@ -156,6 +203,23 @@ namespace netgen
     ///
     void PrintMemInfo (ostream & ost) const;
   private:
+    ///
+    const FlatBox & FindFlat (Point<3> p) const
+    {
+      const FlatBox * box = &flatboxes[0];
+      while (true)
+        {
+          unsigned childnr = 0;
+          if (p(0) > box->xmid[0]) childnr += 1;
+          if (p(1) > box->xmid[1]) childnr += 2;
+          if (dimension == 3 && p(2) > box->xmid[2]) childnr += 4;
+
+          unsigned bit = 1u << childnr;
+          if (!(box->childmask & bit))
+            return *box;
+          box = &flatboxes[box->firstchild + std::bitset<8>(box->childmask & (bit-1)).count()];
+        }
+    }
     /// 
     double GetMinHRec (const Point3d & pmin, const Point3d & pmax,
 		       const GradingBox * box) const;
@@ -0,0 +1,334 @@
+/*
+  Native binary mesh format (*.vol.ngb)
+
+  The file is a header followed by a sequence of blocks. Every block
+  starts with its number of entries and the size of one entry, the data
+  is padded to 8 bytes. Points, segments and volume elements are stored
+  as their in-memory representation, surface elements as fixed size
+  records (geominfo only for elements which have one). Face descriptors,
+  names and identifications are stored through the BinaryArchive.
+
+  Loading maps the file (or reads it in one piece) and copies the blocks
+  into the mesh arrays in parallel.
+*/
+
+#include <mystdlib.h>
+#include "meshing.hpp"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace netgen
+{
+  namespace
+  {
+    constexpr char mesh_binary_magic[8] = { 'N', 'G', 'M', 'E', 'S', 'H', 'B', '\0' };
+    constexpr uint32_t mesh_binary_version = 1;
+
+    struct MeshBinaryHeader
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t sizeof_pointindex;
+      uint32_t sizeof_meshpoint;
+      uint32_t sizeof_segment;
+      uint32_t sizeof_element;
+      uint32_t element2d_maxpoints;
+      int32_t dimension;
+      int32_t geomtype;
+      int64_t numvertices;
+    };
+
+    struct SurfaceElementRecord
+    {
+      int32_t index;
+      int32_t typ;
+      int32_t np;
+      int32_t flags;   // 1 .. visible, 2 .. deleted, 4 .. curved
+      PointIndex pnum[ELEMENT2D_MAXPOINTS];
+    };
+
+    struct SurfaceGeomInfoRecord
+    {
+      int64_t sei;
+      PointGeomInfo geominfo[ELEMENT2D_MAXPOINTS];
+    };
+
+    struct BlockHeader
+    {
+      uint64_t size;
+      uint64_t entry_size;
+    };
+
+    static_assert(std::is_trivially_copyable_v<MeshPoint>);
+    static_assert(std::is_trivially_copyable_v<Segment>);
+    static_assert(std::is_trivially_copyable_v<Element>);
+
+    size_t Padding (size_t n) { return (8 - n % 8) % 8; }
+
+    template <typename T>
+    void WriteBlock (ostream & ost, FlatArray<T> data)
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      BlockHeader bh { data.Size(), sizeof(T) };
+      ost.write (reinterpret_cast<const char*>(&bh), sizeof(bh));
+      size_t n = data.Size() * sizeof(T);
+      ost.write (reinterpret_cast<const char*>(data.Data()), n);
+      char zeros[8] = { 0 };
+      ost.write (zeros, Padding(n));
+    }
+
+    // read-only view of the file content
+    class MeshBinaryFile
+    {
+      const char * data = nullptr;
+      size_t size = 0;
+      size_t pos = 0;
+      Array<char> buffer;
+#ifndef WIN32
+      void * mapped = nullptr;
+#endif
+
+    public:
+      MeshBinaryFile (const filesystem::path & filename)
+      {
+#ifndef WIN32
+        int fd = open (filename.c_str(), O_RDONLY);
+        if (fd < 0)
+          throw NgException ("mesh file not found");
+        struct stat st;
+        fstat (fd, &st);
+        size = st.st_size;
+        if (size)
+          mapped = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close (fd);
+        if (mapped == MAP_FAILED)
+          throw NgException ("cannot map mesh file");
+        data = static_cast<const char*>(mapped);
+#else
+        ifstream ist(filename, ios::binary | ios::ate);
+        if (!ist.good())
+          throw NgException ("mesh file not found");
+        size = ist.tellg();
+        buffer.SetSize(size);
+        ist.seekg(0);
+        ist.read (buffer.Data(), size);
+        data = buffer.Data();
+#endif
+      }
+
+      ~MeshBinaryFile ()
+      {
+#ifndef WIN32
+        if (mapped)
+          munmap (mapped, size);
+#endif
+      }
+
+      const char * Get (size_t n)
+      {
+        if (pos + n > size)
+          throw NgException ("unexpected end of binary mesh file");
+        auto p = data + pos;
+        pos += n;
+        return p;
+      }
+
+      template <typename T>
+      FlatArray<const T> GetBlock ()
+      {
+        auto bh = *reinterpret_cast<const BlockHeader*>(Get(sizeof(BlockHeader)));
+        if (bh.entry_size != sizeof(T))
+          throw NgException ("binary mesh file: incompatible entry size");
+        size_t n = bh.size * sizeof(T);
+        auto p = Get (n + Padding(n));
+        return FlatArray<const T> (bh.size, reinterpret_cast<const T*>(p));
+      }
+    };
+
+    // copy block into array, in parallel
+    template <typename T, typename TIndex>
+    void CopyBlock (FlatArray<const T> src, Array<T, TIndex> & dst)
+    {
+      dst.SetSize (src.Size());
+      ParallelForRange (Range(src.Size()), [&] (auto myrange)
+        {
+          if (myrange.Size())
+            memcpy ((void*)(dst.Data()+myrange.First()), src.Data()+myrange.First(),
+                    myrange.Size()*sizeof(T));
+        });
+    }
+  }
+
+
+  void Mesh :: SaveBinary (const filesystem::path & filename) const
+  {
+    static Timer timer("Mesh::SaveBinary"); RegionTimer rt(timer);
+    ofstream ost(filename, ios::binary);
+    if (!ost.good())
+      throw NgException ("cannot open file " + filename.string());
+
+    MeshBinaryHeader header;
+    memcpy (header.magic, mesh_binary_magic, sizeof(header.magic));
+    header.version = mesh_binary_version;
+    header.sizeof_pointindex = sizeof(PointIndex);
+    header.sizeof_meshpoint = sizeof(MeshPoint);
+    header.sizeof_segment = sizeof(Segment);
+    header.sizeof_element = sizeof(Element);
+    header.element2d_maxpoints = ELEMENT2D_MAXPOINTS;
+    header.dimension = dimension;
+    header.geomtype = geomtype;
+    header.numvertices = numvertices;
+    ost.write (reinterpret_cast<const char*>(&header), sizeof(header));
+
+    WriteBlock (ost, FlatArray<const MeshPoint> (points.Size(), points.Data()));
+    WriteBlock (ost, FlatArray<const Segment> (segments.Size(), segments.Data()));
+    WriteBlock (ost, FlatArray<const Element> (volelements.Size(), volelements.Data()));
+
+    Array<SurfaceElementRecord> sels(surfelements.Size());
+    size_t nse_geominfo = 0;
+    ParallelForRange (Range(surfelements.Size()), [&] (auto myrange)
+      {
+        size_t mycnt = 0;
+        for (auto i : myrange)
+          {
+            const auto & el = surfelements[SurfaceElementIndex(i)];
+            auto & rec = sels[i];
+            rec.index = el.GetIndex();
+            rec.typ = el.GetType();
+            rec.np = el.GetNP();
+            rec.flags = (el.IsVisible() ? 1 : 0) | (el.IsDeleted() ? 2 : 0) | (el.IsCurved() ? 4 : 0);
+            for (int j = 0; j < ELEMENT2D_MAXPOINTS; j++)
+              rec.pnum[j] = j < el.GetNP() ? el[j] : PointIndex(PointIndex::INVALID);
+            if (el.HasGeomInfo())
+              mycnt++;
+          }
+        AsAtomic(nse_geominfo) += mycnt;
+      });
+    WriteBlock (ost, FlatArray<const SurfaceElementRecord> (sels.Size(), sels.Data()));
+
+    Array<SurfaceGeomInfoRecord> gis;
+    gis.SetAllocSize(nse_geominfo);
+    for (auto sei : Range(surfelements))
+      if (surfelements[sei].HasGeomInfo())
+        {
+          SurfaceGeomInfoRecord rec;
+          rec.sei = sei - IndexBASE<SurfaceElementIndex>();
+          auto gi = surfelements[sei].GeomInfo();
+          for (int j = 0; j < ELEMENT2D_MAXPOINTS; j++)
+            rec.geominfo[j] = j < gi.Size() ? gi[j] : PointGeomInfo{};
+          gis.Append (rec);
+        }
+    WriteBlock (ost, FlatArray<const SurfaceGeomInfoRecord> (gis.Size(), gis.Data()));
+
+    Array<PointIndex> pel_pnums(pointelements.Size());
+    Array<int> pel_index(pointelements.Size());
+    for (auto i : Range(pointelements))
+      {
+        pel_pnums[i] = pointelements[i].pnum;
+        pel_index[i] = pointelements[i].index;
+      }
+    WriteBlock (ost, FlatArray<const PointIndex> (pel_pnums.Size(), pel_pnums.Data()));
+    WriteBlock (ost, FlatArray<const int> (pel_index.Size(), pel_index.Data()));
+
+    // small data with variable size through the archive
+    auto ss = make_shared<stringstream>();
+    {
+      BinaryOutArchive ar { shared_ptr<ostream>(ss) };
+      auto & self = const_cast<Mesh&>(*this);
+      ar & self.facedecoding;
+      ar & self.materials & self.bcnames & self.cd2names & self.cd3names;
+      ar & *self.ident;
+    }
+    auto str = ss->str();
+    WriteBlock (ost, FlatArray<const char> (str.size(), str.data()));
+
+    if (!ost.good())
+      throw NgException ("error writing file " + filename.string());
+  }
+
+
+  void Mesh :: LoadBinary (const filesystem::path & filename)
+  {
+    static Timer timer("Mesh::LoadBinary"); RegionTimer rt(timer);
+    MeshBinaryFile file(filename);
+
+    auto header = *reinterpret_cast<const MeshBinaryHeader*>(file.Get(sizeof(MeshBinaryHeader)));
+    if (memcmp (header.magic, mesh_binary_magic, sizeof(header.magic)) != 0)
+      throw NgException ("not a binary netgen mesh file: " + filename.string());
+    if (header.version != mesh_binary_version)
+      throw NgException ("unsupported binary mesh version " + ToString(header.version));
+    if (header.sizeof_pointindex != sizeof(PointIndex) ||
+        header.sizeof_meshpoint != sizeof(MeshPoint) ||
+        header.sizeof_segment != sizeof(Segment) ||
+        header.sizeof_element != sizeof(Element) ||
+        header.element2d_maxpoints != ELEMENT2D_MAXPOINTS)
+      throw NgException ("binary mesh file was written by an incompatible netgen build");
+
+    dimension = header.dimension;
+    geomtype = GEOM_TYPE(header.geomtype);
+    numvertices = header.numvertices;
+
+    CopyBlock (file.GetBlock<MeshPoint>(), points);
+    CopyBlock (file.GetBlock<Segment>(), segments);
+    CopyBlock (file.GetBlock<Element>(), volelements);
+
+    auto sels = file.GetBlock<SurfaceElementRecord>();
+    surfelements.SetSize (sels.Size());
+    ParallelForRange (Range(sels.Size()), [&] (auto myrange)
+      {
+        for (auto i : myrange)
+          {
+            const auto & rec = sels[i];
+            Element2d el(ELEMENT_TYPE(rec.typ));
+            for (int j = 0; j < rec.np; j++)
+              el[j] = rec.pnum[j];
+            el.SetIndex (rec.index);
+            el.Visible (rec.flags & 1);
+            if (rec.flags & 2)
+              el.Delete();
+            el.SetCurved (rec.flags & 4);
+            surfelements[SurfaceElementIndex(i)] = std::move(el);
+          }
+      });
+
+    auto gis = file.GetBlock<SurfaceGeomInfoRecord>();
+    ParallelForRange (Range(gis.Size()), [&] (auto myrange)
+      {
+        for (auto i : myrange)
+          {
+            auto & el = surfelements[SurfaceElementIndex(gis[i].sei)];
+            auto gi = el.GeomInfo();
+            for (auto j : Range(gi))
+              gi[j] = gis[i].geominfo[j];
+          }
+      });
+
+    auto pel_pnums = file.GetBlock<PointIndex>();
+    auto pel_index = file.GetBlock<int>();
+    pointelements.SetSize (pel_pnums.Size());
+    for (auto i : Range(pel_pnums))
+      pointelements[i] = Element0d (pel_pnums[i], pel_index[i]);
+
+    auto str = file.GetBlock<char>();
+    {
+      BinaryInArchive ar(make_shared<istringstream>(string(str.Data(), str.Size())));
+      ar & facedecoding;
+      ar & materials & bcnames & cd2names & cd3names;
+      ar & *ident;
+    }
+
+    RebuildSurfaceElementLists();
+    CalcSurfacesOfNode ();
+    if (GetCommunicator().Size() == 1) // sequential run only
+      {
+        topology.Update();
+        clusters -> Update();
+      }
+    SetNextMajorTimeStamp();
+  }
+}
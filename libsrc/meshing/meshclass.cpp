@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <mystdlib.h>
 #include <atomic>
+#include <charconv>
 #include <regex>
 #include <set>
 #include "core/array.hpp"
@@ -653,6 +654,12 @@ namespace netgen
         return;
     }
 
+    if (ext0 == ".vol" && ext == ".ngb")
+    {
+        SaveBinary(filename);
+        return;
+    }
+
     ostream * outfile;
     if (ext0 == ".vol" && ext == ".gz")
       outfile = new ogzstream(filename);
@@ -1152,6 +1159,12 @@ namespace netgen
         return;
     }
 
+    if (ext0 == ".vol" && ext == ".ngb")
+    {
+        LoadBinary(filename);
+        return;
+    }
+
     istream * infile = NULL;
 
     if (ext0 == ".vol" && ext == ".gz")
@@ -1193,6 +1206,156 @@ namespace netgen
         throw Exception("Reached end of file while parsing");
   }
 
+
+  namespace
+  {
+    // parses numbers from one line of a section, same results as operator>>
+    class VolLineParser
+    {
+      const char * p;
+      const char * end;
+      bool ok = true;
+
+      void SkipSpace ()
+      {
+        while (p < end && isspace(static_cast<unsigned char>(*p))) p++;
+      }
+
+      template <typename T>
+      VolLineParser & Get (T & val)
+      {
+        SkipSpace();
+        auto [next, ec] = std::from_chars (p, end, val);
+        if (ec != std::errc() || (next < end && !isspace(static_cast<unsigned char>(*next))))
+          {
+            ok = false;
+            val = 0;
+            p = end;
+          }
+        else
+          p = next;
+        return *this;
+      }
+
+    public:
+      VolLineParser (string_view line)
+        : p(line.data()), end(line.data()+line.size()) { }
+
+      VolLineParser & operator>> (int & i) { return Get(i); }
+
+      VolLineParser & operator>> (double & d)
+      {
+#ifdef __cpp_lib_to_chars
+        return Get(d);
+#else
+        SkipSpace();
+        if (p == end) { ok = false; d = 0; return *this; }
+        char * next;
+        d = strtod (p, &next);
+        if (next == p || (next < end && !isspace(static_cast<unsigned char>(*next))))
+          {
+            ok = false;
+            d = 0;
+            p = end;
+          }
+        else
+          p = next;
+        return *this;
+#endif
+      }
+
+      VolLineParser & operator>> (PointIndex & pi)
+      {
+        int i;
+        Get(i);
+        pi = IndexBASE<PointIndex>()+i-1;
+        return *this;
+      }
+
+      // all entries read and nothing left on the line
+      bool Good () { SkipSpace(); return ok && p == end; }
+    };
+
+    // continues reading from the stream when the buffered lines are used up
+    class VolChainedInput
+    {
+      istringstream first;
+      istream & second;
+    public:
+      VolChainedInput (string buffer, istream & asecond)
+        : first(std::move(buffer)), second(asecond) { }
+
+      template <typename T>
+      VolChainedInput & operator>> (T & val)
+      {
+        if (!first.fail())
+          {
+            first >> val;
+            if (!first.fail()) return *this;
+          }
+        second >> val;
+        return *this;
+      }
+
+      bool HasUnusedInput ()
+      {
+        if (first.fail()) return false;
+        first >> std::ws;
+        return !first.eof();
+      }
+    };
+
+    /*
+      Reads data.Size() entries of a section. Netgen writes one entry per
+      line, so the lines are read in one go and parsed in parallel. If a
+      section is formatted differently the entries are parsed sequentially.
+     */
+    template <typename T, typename TFunc>
+    void ReadVolSection (istream & ist, FlatArray<T> data, TFunc func)
+    {
+      string buffer;
+      Array<size_t> first;
+      string line;
+      while (first.Size() < data.Size() && std::getline(ist, line))
+        {
+          if (std::all_of (line.begin(), line.end(),
+                           [](char c) { return isspace(static_cast<unsigned char>(c)); }))
+            continue;
+          first.Append (buffer.size());
+          buffer += line;
+          buffer += '\n';
+        }
+      first.Append (buffer.size());
+
+      bool ok = first.Size() == data.Size()+1;
+      if (ok)
+        {
+          std::atomic<bool> all_good = true;
+          ParallelForRange (Range(data.Size()), [&] (auto myrange)
+            {
+              for (auto i : myrange)
+                {
+                  VolLineParser parser(string_view(buffer).substr(first[i], first[i+1]-first[i]));
+                  func (parser, data[i]);
+                  if (!parser.Good())
+                    all_good = false;
+                }
+            });
+          ok = all_good;
+        }
+
+      if (!ok)
+        {
+          VolChainedInput input(std::move(buffer), ist);
+          for (auto & val : data)
+            func (input, val);
+          if (input.HasUnusedInput())
+            throw NgException ("cannot read mesh file: more than one entry per line");
+        }
+    }
+  }
+
+
   void Mesh :: Load (istream & infile)
   {
     static Timer timer("Mesh::Load"); RegionTimer rt(timer);
@@ -1260,58 +1423,67 @@ namespace netgen
 	    bool uv = strcmp (str, "surfaceelementsuv") == 0;
 
 
-            for (i = 1; i <= n; i++)
+            struct SurfaceElementEntry
+            {
+              int surfnr, bcp, domin, domout;
+              Element2d el;
+            };
+            Array<SurfaceElementEntry> entries(n);
+            ReadVolSection (infile, FlatArray<SurfaceElementEntry>(entries), [&] (auto & in, SurfaceElementEntry & entry)
               {
-                int surfnr, bcp, domin, domout, nep, faceind = 0;
-
-                infile >> surfnr >> bcp >> domin >> domout;
-                surfnr--;
+                int nep;
+                in >> entry.surfnr >> entry.bcp >> entry.domin >> entry.domout;
+                entry.surfnr--;
 
-		bool invert_el = false;
-		/*
-		if (domin == 0) 
-		  {
-		    invert_el = true;
-		    Swap (domin, domout);
-		  }
-		*/
-		
-                for (int j = 1; j <= facedecoding.Size(); j++)
-                  if (GetFaceDescriptor(j).SurfNr() == surfnr &&
-                      GetFaceDescriptor(j).BCProperty() == bcp &&
-                      GetFaceDescriptor(j).DomainIn() == domin &&
-                      GetFaceDescriptor(j).DomainOut() == domout)
-                    faceind = j;
-
-		// if (facedecoding.Size()) faceind = 1;   // for timing 
-
-                if (!faceind)
-                  {
-                    faceind = AddFaceDescriptor (FaceDescriptor(surfnr, domin, domout, 0));
-                    GetFaceDescriptor(faceind).SetBCProperty (bcp);
-                  }
-
-                infile >> nep;
+                in >> nep;
                 if (!nep) nep = 3;
 
                 Element2d tri(nep);
-                tri.SetIndex(faceind);
-
                 for (int j = 1; j <= nep; j++)
-                  infile >> tri.PNum(j);
+                  in >> tri.PNum(j);
 
                 if (geominfo)
                   for (int j = 1; j <= nep; j++)
-                    infile >> tri.GeomInfoPi(j).trignum;
+                    in >> tri.GeomInfoPi(j).trignum;
 
                 if (uv)
                   for (int j = 1; j <= nep; j++)
-                    infile >> tri.GeomInfoPi(j).u >> tri.GeomInfoPi(j).v;
-		
+                    in >> tri.GeomInfoPi(j).u >> tri.GeomInfoPi(j).v;
+
                 if (invertsurf) tri.Invert();
-		if (invert_el) tri.Invert();
+                entry.el = std::move(tri);
+              });
+
+            surfelements.SetAllocSize (surfelements.Size()+n);
+            // consecutive elements are mostly on the same face
+            int last_faceind = 0;
+            INDEX_4 last_key;
+            for (auto & entry : entries)
+              {
+                INDEX_4 key(entry.surfnr, entry.bcp, entry.domin, entry.domout);
+                int faceind = 0;
+                if (last_faceind && key == last_key)
+                  faceind = last_faceind;
+                else
+                  {
+                    for (int j = 1; j <= facedecoding.Size(); j++)
+                      if (GetFaceDescriptor(j).SurfNr() == entry.surfnr &&
+                          GetFaceDescriptor(j).BCProperty() == entry.bcp &&
+                          GetFaceDescriptor(j).DomainIn() == entry.domin &&
+                          GetFaceDescriptor(j).DomainOut() == entry.domout)
+                        faceind = j;
+
+                    if (!faceind)
+                      {
+                        faceind = AddFaceDescriptor (FaceDescriptor(entry.surfnr, entry.domin, entry.domout, 0));
+                        GetFaceDescriptor(faceind).SetBCProperty (entry.bcp);
+                      }
+                    last_faceind = faceind;
+                    last_key = key;
+                  }
 
-		AddSurfaceElement (tri);
+                entry.el.SetIndex(faceind);
+                AddSurfaceElement (entry.el);
               }
           }
 
@@ -1320,24 +1492,30 @@ namespace netgen
             static Timer t1("read volume elements"); RegionTimer rt1(t1);
             infile >> n;
             PrintMessage (3, n, " volume elements");
-            for (i = 1; i <= n; i++)
+            size_t oldne = volelements.Size();
+            volelements.SetSize (oldne+n);
+            ReadVolSection (infile, volelements.Range(oldne, oldne+n), [&] (auto & in, Element & vel)
               {
                 Element el(TET);
                 int hi, nep;
-                infile >> hi;
+                in >> hi;
                 if (hi == 0) hi = 1;
                 el.SetIndex(hi);
-                infile >> nep;
+                in >> nep;
                 el.SetNP(nep);
                 el.SetCurved (nep != 4);
                 for (int j = 0; j < nep; j++)
-                  infile >> el[j];
+                  in >> el[j];
 
                 if (inverttets)
                   el.Invert();
 
-		AddVolumeElement (el);
-              }
+                el.Touch();
+                el.Flags().fixed = 0;
+                el.Flags().deleted = 0;
+                vel = el;
+              });
+            timestamp = NextTimeStamp();
           }
 
 
@@ -1345,13 +1523,15 @@ namespace netgen
           {
             static Timer t1("read edge segments"); RegionTimer rt1(t1);
             infile >> n;
-            for (i = 1; i <= n; i++)
+            Array<Segment> segs(n);
+            ReadVolSection (infile, FlatArray<Segment>(segs), [&] (auto & in, Segment & seg)
               {
-                Segment seg;
                 int hi;
-                infile >> seg.si >> hi >> seg[0] >> seg[1];
-                AddSegment (seg);
-              }
+                in >> seg.si >> hi >> seg[0] >> seg[1];
+              });
+            segments.SetAllocSize (segments.Size()+n);
+            for (auto & seg : segs)
+              AddSegment (seg);
           }
 
 
@@ -1360,15 +1540,17 @@ namespace netgen
           {
             static Timer t1("read edge segmentsgi"); RegionTimer rt1(t1);
             infile >> n;
-            for (i = 1; i <= n; i++)
+            Array<Segment> segs(n);
+            ReadVolSection (infile, FlatArray<Segment>(segs), [&] (auto & in, Segment & seg)
               {
-                Segment seg;
                 int hi;
-                infile >> seg.si >> hi >> seg[0] >> seg[1]
-                       >> seg.geominfo[0].trignum
-                       >> seg.geominfo[1].trignum;
-                AddSegment (seg);
-              }
+                in >> seg.si >> hi >> seg[0] >> seg[1]
+                   >> seg.geominfo[0].trignum
+                   >> seg.geominfo[1].trignum;
+              });
+            segments.SetAllocSize (segments.Size()+n);
+            for (auto & seg : segs)
+              AddSegment (seg);
           }
 
         if (strcmp (str, "edgesegmentsgi2") == 0)
@@ -1380,18 +1562,18 @@ namespace netgen
 
             PrintMessage (3, n, " curve elements");
 
-            for (i = 1; i <= n; i++)
+            Array<Segment> segs(n);
+            ReadVolSection (infile, FlatArray<Segment>(segs), [&] (auto & in, Segment & seg)
               {
-                Segment seg;
                 int hi;
-                infile >> seg.si >> hi >> seg[0] >> seg[1]
-                       >> seg.geominfo[0].trignum
-                       >> seg.geominfo[1].trignum
-                       >> seg.surfnr1 >> seg.surfnr2
-                       >> seg.edgenr
-                       >> seg.epgeominfo[0].dist
-                       >> seg.epgeominfo[1].edgenr
-                       >> seg.epgeominfo[1].dist;
+                in >> seg.si >> hi >> seg[0] >> seg[1]
+                   >> seg.geominfo[0].trignum
+                   >> seg.geominfo[1].trignum
+                   >> seg.surfnr1 >> seg.surfnr2
+                   >> seg.edgenr
+                   >> seg.epgeominfo[0].dist
+                   >> seg.epgeominfo[1].edgenr
+                   >> seg.epgeominfo[1].dist;
 
                 seg.epgeominfo[0].edgenr = seg.epgeominfo[1].edgenr;
 
@@ -1400,9 +1582,10 @@ namespace netgen
 
                 seg.surfnr1--;
                 seg.surfnr2--;
-
-                AddSegment (seg);
-              }
+              });
+            segments.SetAllocSize (segments.Size()+n);
+            for (auto & seg : segs)
+              AddSegment (seg);
           }
 
         if (strcmp (str, "points") == 0)
@@ -1410,15 +1593,18 @@ namespace netgen
             static Timer t1("read points"); RegionTimer rt1(t1);
             infile >> n;
             PrintMessage (3, n, " points");
-            for (i = 1; i <= n; i++)
+            size_t oldnp = points.Size();
+            points.SetSize (oldnp+n);
+            ReadVolSection (infile, points.Range(oldnp, oldnp+n), [&] (auto & in, MeshPoint & mp)
               {
                 Point3d p;
-                infile >> p.X() >> p.Y() >> p.Z();
+                in >> p.X() >> p.Y() >> p.Z();
                 p.X() *= scale;
                 p.Y() *= scale;
                 p.Z() *= scale;
-                AddPoint (p);
-              }
+                mp = MeshPoint (p, 1, INNERPOINT);
+              });
+            timestamp = NextTimeStamp();
 	    PrintMessage (3, n, " points done");
           }
 
@@ -3396,6 +3582,32 @@ namespace netgen
     lochfunc[layer-1] -> SetH (p, hloc);
   }
 
+  void Mesh :: BeginRestrictLocalH (int layer)
+  {
+    if (!lochfunc[layer-1])
+      {
+        PrintWarning("BeginRestrictLocalH called, creating mesh-size tree");
+
+        Point3d boxmin, boxmax;
+        GetBox (boxmin, boxmax);
+        SetLocalH (boxmin, boxmax, 0.8, layer);
+      }
+    lochfunc[layer-1] -> BeginConcurrentSetH();
+  }
+
+  void Mesh :: RestrictLocalHConcurrent (const Point3d & p, double hloc,
+                                         size_t key, int layer)
+  {
+    if(hloc < hmin)
+      hloc = hmin;
+    lochfunc[layer-1] -> SetHConcurrent (p, hloc, key);
+  }
+
+  void Mesh :: EndRestrictLocalH (int layer)
+  {
+    lochfunc[layer-1] -> EndConcurrentSetH();
+  }
+
   void Mesh :: RestrictLocalHLine (const Point3d & p1, 
                                    const Point3d & p2,
                                    double hloc, int layer)
@@ -4595,6 +4807,9 @@ namespace netgen
     tets_in_qualclass.SetSize(n_classes);
     tets_in_qualclass = 0;
 
+    // only coordinates are read, use the compact copy
+    PointCoordinates coords(points);
+
     ParallelForRange( IntRange(volelements.Size()), [&] (auto myrange)
        {
          double local_sum = 0.0;
@@ -4608,7 +4823,7 @@ namespace netgen
 
          for (auto i : myrange)
            {
-             double elbad = pow (max2(CalcBad (points, volelements[i], 0, mp),1e-10), 1/teterrpow);
+             double elbad = pow (max2(CalcBad (coords, volelements[i], 0, mp),1e-10), 1/teterrpow);
 
              int qualclass = int (n_classes / elbad + 1);
              if (qualclass < 1) qualclass = 1;
@@ -6063,6 +6278,112 @@ namespace netgen
 
 
 
+  // walks from start towards p over the faces of straight tets, returns
+  // invalid index if the walk leaves the mesh or reaches another element
+  static ElementIndex WalkToElement (const Mesh & mesh,
+                                     const netgen::Point<3> & p,
+                                     ElementIndex start,
+                                     double * lami,
+                                     double tol)
+  {
+    const auto & topology = mesh.GetTopology();
+    const auto & curved = mesh.GetCurvedElements();
+    ElementIndex ei = start;
+    for ([[maybe_unused]] auto step : Range(20))
+      {
+        const Element & el = mesh[ei];
+        if (el.GetType() != TET || curved.IsElementCurved(ei))
+          return ElementIndex::INVALID;
+
+        // barycentric coordinates, vertex 3 is the origin of the reference tet
+        const auto & p3 = mesh[el[3]];
+        Mat<3,3> mat;
+        for (int j = 0; j < 3; j++)
+          {
+            Vec<3> v = mesh[el[j]] - p3;
+            for (int k = 0; k < 3; k++)
+              mat(k,j) = v(k);
+          }
+        Vec<3> lam;
+        mat.Solve (p-p3, lam);
+        double lam4[4] = { lam(0), lam(1), lam(2), 1.0-lam(0)-lam(1)-lam(2) };
+
+        // leave through the face opposite to the vertex with smallest coordinate
+        int k = 0;
+        for (int j = 1; j < 4; j++)
+          if (lam4[j] < lam4[k]) k = j;
+
+        // same criterion as PointContainedIn3DElement
+        if (lam4[k] > -tol)
+          {
+            for (int j = 0; j < 3; j++)
+              lami[j] = lam(j);
+            return ei;
+          }
+
+        ArrayMem<PointIndex,3> face;
+        for (int j = 0; j < 4; j++)
+          if (j != k) face.Append (el[j]);
+
+        ElementIndex next = ElementIndex::INVALID;
+        for (auto ej : topology.GetVertexElements(face[0]))
+          {
+            if (ej == ei || mesh[ej].IsDeleted()) continue;
+            auto verts = mesh[ej].PNums().Range(0, mesh[ej].GetNV());
+            if (verts.Contains(face[1]) && verts.Contains(face[2]))
+              {
+                next = ej;
+                break;
+              }
+          }
+        if (!next.IsValid())
+          return ElementIndex::INVALID;
+        ei = next;
+      }
+    return ElementIndex::INVALID;
+  }
+
+  void Mesh :: GetElementsOfPoints (FlatArray<const netgen::Point<3>> pts,
+                                    FlatArray<ElementIndex> els,
+                                    FlatArray<Vec<3>> lamis,
+                                    double tol) const
+  {
+    static Timer timer("Mesh::GetElementsOfPoints"); RegionTimer rt(timer);
+    const_cast<Mesh&>(*this).BuildElementSearchTree (3);
+    if (topology.HasVertex2Element() && topology.NeedsUpdate() && GetCommunicator().Size() == 1)
+      {
+        std::lock_guard<std::mutex> guard(buildsearchtree_mutex);
+        if (topology.NeedsUpdate())
+          const_cast<MeshTopology&>(topology).Update();
+      }
+    bool walk = topology.HasVertex2Element() && !topology.NeedsUpdate();
+
+    ParallelForRange (Range(pts.Size()), [&] (auto myrange)
+      {
+        // every task starts from its own previous hit
+        ElementIndex last = ElementIndex::INVALID;
+        for (auto i : myrange)
+          {
+            double lami[3] = { 0, 0, 0 };
+            ElementIndex ei = ElementIndex::INVALID;
+            if (walk && last.IsValid())
+              ei = WalkToElement (*this, pts[i], last, lami, tol);
+            if (!ei.IsValid())
+              ei = Find3dElement (*this, pts[i], lami, nullopt,
+                                  elementsearchtree_vol.get(), true, tol);
+            if (ei.IsValid())
+              {
+                last = ei;
+                lamis[i] = Vec<3> (lami[0], lami[1], lami[2]);
+              }
+            else
+              lamis[i] = Vec<3> (0, 0, 0);
+            els[i] = ei;
+          }
+      });
+  }
+
+
   SurfaceElementIndex Mesh ::
   GetSurfaceElementOfPoint (const netgen::Point<3> & p,
                             double* lami,
@@ -7668,6 +7989,16 @@ namespace netgen
         << sizeof (Element2d) << " = " 
         << GetNSE() * sizeof(Element2d) << endl;
 
+    size_t nse_geominfo = 0;
+    for (const auto & el : surfelements)
+      if (el.HasGeomInfo())
+        nse_geominfo++;
+    constexpr size_t geominfo_size = ELEMENT2D_MAXPOINTS * sizeof(PointGeomInfo);
+    ost << nse_geominfo << " Surface element geominfos, of size " 
+        << geominfo_size << " = " 
+        << nse_geominfo * geominfo_size 
+        << " (saved " << (GetNSE()-nse_geominfo) * geominfo_size << ")" << endl;
+
     ost << GetNE() << " Volume elements, of size " 
         << sizeof (Element) << " = " 
         << GetNE() * sizeof(Element) << endl;
@@ -7684,6 +8015,12 @@ namespace netgen
       surfelementht->PrintMemInfo (cout);
   }
 
+  void Mesh :: ClearGeomInfo ()
+  {
+    for (auto & el : surfelements)
+      el.ClearGeomInfo();
+  }
+
   shared_ptr<Mesh> Mesh :: Mirror ( netgen::Point<3> p_plane, Vec<3> n_plane )
   {
     Mesh & m = *this;
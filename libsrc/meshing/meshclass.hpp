@@ -493,6 +493,13 @@ namespace netgen
     ///
     DLL_HEADER void RestrictLocalHLine (const Point3d & p1, const Point3d & p2, 
 			     double hloc, int layer=1);
+    /// start restricting the mesh size from several threads
+    DLL_HEADER void BeginRestrictLocalH (int layer=1);
+    /// thread-safe RestrictLocalH, see LocalH::SetHConcurrent
+    DLL_HEADER void RestrictLocalHConcurrent (const Point3d & p, double hloc,
+                                              size_t key, int layer=1);
+    /// apply the concurrent restrictions
+    DLL_HEADER void EndRestrictLocalH (int layer=1);
     /// number of elements per radius
     DLL_HEADER void CalcLocalHFromSurfaceCurvature(double grading, double elperr, int layer=1);
     ///
@@ -503,6 +510,8 @@ namespace netgen
     DLL_HEADER void LoadLocalMeshSize (const filesystem::path & meshsizefilename);
     ///
     DLL_HEADER void SetGlobalH (double h);
+    ///
+    double GetGlobalH () const { return hglob; }
     ///
 	DLL_HEADER void SetMinimalH (double h);
     ///
@@ -596,6 +605,13 @@ namespace netgen
     */
     DLL_HEADER void Compress ();
 
+    /**
+       Release the geominfo of all surface elements. It is needed for
+       surface meshing, optimization, refinement and curving, so only
+       call this on meshes which are not processed further.
+    */
+    DLL_HEADER void ClearGeomInfo ();
+
     /// first vertex has lowest index
     void OrderElements(); 
 
@@ -611,6 +627,10 @@ namespace netgen
 	DLL_HEADER void Load (const filesystem::path & filename);
     ///
 	DLL_HEADER void Merge (const filesystem::path & filename, const int surfindex_offset = 0);
+    /// native binary format (*.vol.ngb), see meshbinary.cpp
+	DLL_HEADER void SaveBinary (const filesystem::path & filename) const;
+    ///
+	DLL_HEADER void LoadBinary (const filesystem::path & filename);
 
 
     DLL_HEADER void DoArchive (Archive & archive);
@@ -702,6 +722,14 @@ namespace netgen
                        bool build_searchtree = 0,
                        bool allowindex = true,
                        double tol=1e-4) const;
+    /// locates many points in parallel, invalid index if not found.
+    /// walks from the previous hit over neighbouring tets, uses the
+    /// search tree (rebuilt if the mesh has changed) otherwise
+    DLL_HEADER void
+    GetElementsOfPoints (FlatArray<const netgen::Point<3>> pts,
+                         FlatArray<ElementIndex> els,
+                         FlatArray<Vec<3>> lamis,
+                         double tol=1e-4) const;
     DLL_HEADER SurfaceElementIndex
     GetSurfaceElementOfPoint (const netgen::Point<3> & p,
                               double * lami,
@@ -388,6 +388,118 @@ namespace netgen
   }
 
 
+  void MergeMeshes( Mesh & mesh, FlatArray<Mesh> meshes, PointIndex first_new_pi );
+
+  // Fill slabs of the domain concurrently. Every slab gets the whole front
+  // and its own copy of the points, but only elements inside the slab
+  // shrunk by a safety layer are generated. A second pass with slabs
+  // centered at the first cuts fills the layers in between, the serial
+  // meshing closes what is left
+  void MeshSubRegions( MeshingData & md, const Box<3> & domain_bbox )
+  {
+    static Timer t("MeshSubRegions"); RegionTimer rt(t);
+    auto & mesh = *md.mesh;
+    auto domain = md.domain;
+    const MeshingParameters & mp = md.mp;
+
+    int nopen = mesh.GetNOpenElements();
+    int nregions = min2 (mp.parallel_volume_subregions, nopen / 200);
+    if (nregions < 2)
+      return;
+
+    // cut along the longest axis, balanced by the number of front faces
+    Vec<3> diag = domain_bbox.PMax() - domain_bbox.PMin();
+    int dir = 0;
+    for (int j = 1; j < 3; j++)
+      if (diag[j] > diag[dir]) dir = j;
+
+    Array<double> coords(nopen);
+    double hmax = 0;
+    for (int i = 0; i < nopen; i++)
+      {
+        const Element2d & sel = mesh.OpenElement(i+1);
+        Point<3> c = Center (mesh[sel[0]], mesh[sel[1]], mesh[sel[2]]);
+        coords[i] = c[dir];
+        hmax = max2 (hmax, mesh.GetH (c));
+        for (int j = 0; j < sel.GetNP(); j++)
+          hmax = max2 (hmax, Dist (mesh[sel[j]], mesh[sel[(j+1) % sel.GetNP()]]));
+      }
+    std::sort (coords.begin(), coords.end());
+
+    Array<double> cuts, centers;
+    for (int i = 1; i < nregions; i++)
+      cuts.Append (coords[i*nopen/nregions]);
+    for (int i = 0; i < nregions; i++)
+      centers.Append (0.5 * ((i == 0 ? domain_bbox.PMin()[dir] : cuts[i-1]) +
+                             (i == nregions-1 ? domain_bbox.PMax()[dir] : cuts[i])));
+
+    PrintMessage (3, "Mesh ", nregions, " subregions of domain ", domain);
+
+    RegionTaskManager rtm(mp.nthreads);
+    for (auto pcuts : { &cuts, &centers })
+      {
+        auto & pass_cuts = *pcuts;
+        Array<Box<3>> regions;
+        for (int i = 0; i <= pass_cuts.Size(); i++)
+          {
+            Point<3> pmin = domain_bbox.PMin();
+            Point<3> pmax = domain_bbox.PMax();
+            if (i > 0)
+              pmin[dir] = pass_cuts[i-1] + 0.5*hmax;
+            if (i < pass_cuts.Size())
+              pmax[dir] = pass_cuts[i] - 0.5*hmax;
+            if (pmin[dir] < pmax[dir])
+              regions.Append (Box<3> (pmin, pmax));
+          }
+
+        auto first_new_pi = mesh.Points().Range().Next();
+        Array<Mesh> meshes(regions.Size());
+
+        ParallelFor( regions.Range(), [&](int i)
+          {
+            Mesh & m = meshes[i];
+            m.Points() = mesh.Points();
+            m.SetLocalH (mesh.GetLocalH());
+            m.SetGlobalH (mesh.GetGlobalH());
+
+            // as for the first step of the serial meshing
+            MeshingParameters mpi = mp;
+            mpi.giveuptol = 25;
+            mpi.sloppy = 5;
+
+            Meshing3 meshing(tetrules);
+            meshing.SetRegion (regions[i]);
+
+            Array<PointIndex, PointIndex> glob2loc(mesh.GetNP());
+            glob2loc = PointIndex::INVALID;
+
+            for (PointIndex pi : mesh.Points().Range())
+              if (domain_bbox.IsIn (mesh[pi]))
+                glob2loc[pi] = meshing.AddPoint (mesh[pi], pi);
+
+            for (auto sel : mesh.OpenElements())
+              {
+                for(auto & pi : sel.PNums())
+                  pi = glob2loc[pi];
+                meshing.AddBoundaryElement (sel);
+              }
+
+            meshing.GenerateMesh (m, mpi);
+
+            for (auto & el : m.VolumeElements())
+              el.SetIndex (domain);
+          }, regions.Size());
+
+        MergeMeshes (mesh, meshes, first_new_pi);
+
+        mesh.CalcSurfacesOfNode();
+        mesh.FindOpenElements(domain);
+        if (!mesh.GetNOpenElements())
+          break;
+      }
+  }
+
+
   void MeshDomain( MeshingData & md)
   {
     auto & mesh = *md.mesh;
@@ -430,6 +542,10 @@ namespace netgen
      }
     domain_bbox.Increase (0.01 * domain_bbox.Diam());
 
+    if (mp.parallel_meshing && mp.parallel_volume_subregions > 1 &&
+        mesh.GetNOpenElements())
+      MeshSubRegions (md, domain_bbox);
+
     int cntsteps = 0;
     int meshed;
     if (mesh.GetNOpenElements())
@@ -634,6 +750,8 @@ namespace netgen
 
      if (!mesh3d.HasLocalHFunction())
          mesh3d.CalcLocalH(mp.grading);
+     // volume meshing only reads the mesh size
+     mesh3d.GetLocalH()->Freeze();
 
      auto md = DivideMesh(mesh3d, mp);
 
@@ -704,6 +822,8 @@ namespace netgen
     */
 
     mesh3d.CalcSurfacesOfNode();
+    if (auto & loch = mesh3d.GetLocalH(); loch)
+      loch->Freeze();
 
     MeshOptimize3d optmesh(mesh3d, mp);
 
@@ -247,6 +247,18 @@ GenerateMesh (Mesh & mesh, const MeshingParameters & mp)
 
   adfront->SetStartFront (mp.baseelnp);
 
+  if (region)
+    for (int i = 1; i <= adfront->Faces().Size(); i++)
+      {
+	const MiniElement2d & face = adfront->GetFace (i);
+	for (int j = 0; j < face.GetNP(); j++)
+	  if (!region->IsIn (adfront->GetPoint (face[j])))
+	    {
+	      adfront->FreezeFace (i);
+	      break;
+	    }
+      }
+
 
   found = 0;
   stat.vol0 = adfront -> Volume();
@@ -281,6 +293,10 @@ GenerateMesh (Mesh & mesh, const MeshingParameters & mp)
 
 
       int baseelem = adfront -> SelectBaseElement ();
+      // all faces inside the region are done
+      if (region && adfront->FaceFrozen (baseelem))
+	break;
+
       if (mp.baseelnp && adfront->GetFace (baseelem).GetNP() != mp.baseelnp)
 	{
 	  adfront->IncrementClass (baseelem);	  
@@ -387,9 +403,19 @@ GenerateMesh (Mesh & mesh, const MeshingParameters & mp)
               onlytri = 0;
             
               
+	  auto group_in_region = [&] ()
+	    {
+	      if (!region) return true;
+	      if (!region->IsIn (inp)) return false;
+	      for (auto & gp : grouppoints)
+		if (!region->IsIn (gp)) return false;
+	      return true;
+	    };
+
 	  if (onlytri && groupfaces.Size() <= 20 + 2*stat.qualclass &&
 	      FindInnerPoint (grouppoints, groupfaces, inp) &&
-              !adfront->PointInsideGroup(grouppindex, groupfaces))
+              !adfront->PointInsideGroup(grouppindex, groupfaces) &&
+              group_in_region())
 	    {
 	      (*testout) << "inner point found" << endl;
 
@@ -450,6 +476,7 @@ GenerateMesh (Mesh & mesh, const MeshingParameters & mp)
       minwithoutother = 1e10;
 
       bool impossible = 1;
+      bool outside_region = false;
 
       for (int rotind = 1; rotind <= locfaces[0].GetNP(); rotind++)
 	{
@@ -557,6 +584,16 @@ GenerateMesh (Mesh & mesh, const MeshingParameters & mp)
 		      found = 0;
 		  }
 	    }
+	  if (found && region)
+	    {
+	      for (int i = 1; i <= locelements.Size(); i++)
+		for (int j = 1; j <= locelements.Get(i).GetNP(); j++)
+		  if (!region->IsIn (locpoints[locelements.Get(i).PNum(j)]))
+		    {
+		      found = 0;
+		      outside_region = true;
+		    }
+	    }
 
 
 	  if (found)
@@ -713,6 +750,12 @@ GenerateMesh (Mesh & mesh, const MeshingParameters & mp)
 	  for(int i = 1; i <= delfaces.Size(); i++)
 	    adfront->DeleteFace (findex[delfaces.Get(i)-1]);
 	}
+      else if (region && (outside_region || stat.qualclass+1 >= min2 (mp.giveuptol, 4)))
+	{
+	  // faces at the border of the region, or failing repeatedly, are
+	  // left for meshing the remaining front without region
+	  adfront->FreezeFace (findex[0]);
+	}
       else
 	{
 	  adfront->IncrementClass (findex[0]);
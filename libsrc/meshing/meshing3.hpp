@@ -32,6 +32,8 @@ class Meshing3
   Array<string> problems;
   /// tolerance criterion
   double tolfak;
+  /// new elements must be inside, if set
+  optional<Box<3>> region;
 public:
   /// 
   Meshing3 (const string & rulefilename); 
@@ -63,6 +65,9 @@ public:
   void AddBoundaryElement (const MiniElement2d & elem);
   ///
   int AddConnectedPair (const INDEX_2 & pair);
+  /// generate only elements inside the box, the front is not advanced
+  /// from faces outside
+  void SetRegion (const Box<3> & box) { region = box; }
   
   ///
   void BlockFill (Mesh & mesh, double gh);
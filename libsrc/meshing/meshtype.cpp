@@ -179,6 +179,17 @@ namespace netgen
    ar & pnum & index;
  }
 
+  void PointCoordinates :: Update (const T_POINTS & points)
+  {
+    static Timer t("PointCoordinates::Update"); RegionTimer reg(t);
+    coords.SetSize(points.Size());
+    ParallelForRange (points.Range(), [&] (auto myrange)
+      {
+        for (auto pi : myrange)
+          coords[pi] = points[pi];
+      });
+  }
+
   Segment :: Segment() 
     : is_curved(false)
   {
@@ -236,10 +247,7 @@ namespace netgen
   Element2d :: Element2d ()
   {
     for (int i = 0; i < ELEMENT2D_MAXPOINTS; i++)
-      {
-	pnum[i].Invalidate();
-	geominfo[i].trignum = 0;
-      }
+      pnum[i].Invalidate();
     np = 3;
     index = 0;
     badel = 0;
@@ -255,10 +263,7 @@ namespace netgen
   Element2d :: Element2d (int anp)
   { 
     for (int i = 0; i < ELEMENT2D_MAXPOINTS; i++)
-      {
-        pnum[i].Invalidate();
-	geominfo[i].trignum = 0;
-      }
+      pnum[i].Invalidate();
     np = anp;
     index = 0;
     badel = 0;
@@ -280,10 +285,7 @@ namespace netgen
   Element2d :: Element2d (ELEMENT_TYPE atyp)
   { 
     for (int i = 0; i < ELEMENT2D_MAXPOINTS; i++)
-      {
-        pnum[i].Invalidate();
-	geominfo[i].trignum = 0;
-      }
+      pnum[i].Invalidate();
 
     SetType (atyp);
 
@@ -309,9 +311,7 @@ namespace netgen
     
     for (int i = 3; i < ELEMENT2D_MAXPOINTS; i++)
       pnum[i].Invalidate();
-  
-    for (int i = 0; i < ELEMENT2D_MAXPOINTS; i++)
-      geominfo[i].trignum = 0;
+
     index = 0;
     badel = 0;
     refflag = 1;
@@ -333,9 +333,7 @@ namespace netgen
 
     pnum[4].Invalidate();
     pnum[5].Invalidate();
-  
-    for (int i = 0; i < ELEMENT2D_MAXPOINTS; i++)
-      geominfo[i].trignum = 0;
+
     index = 0;
     badel = 0;
     refflag = 1;
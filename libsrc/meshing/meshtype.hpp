@@ -600,16 +600,79 @@ namespace netgen
   typedef Array<MeshPoint, PointIndex> T_POINTS;
 
 
+  /**
+     Coordinates of mesh points, stored contiguously without the point
+     attributes (24 instead of 40 bytes per point). A snapshot for loops
+     which only read coordinates, call Update after points moved.
+  */
+  class PointCoordinates
+  {
+    Array<Point<3>, PointIndex> coords;
+  public:
+    PointCoordinates () = default;
+    PointCoordinates (const T_POINTS & points) { Update(points); }
+
+    DLL_HEADER void Update (const T_POINTS & points);
+
+    size_t Size () const { return coords.Size(); }
+    auto Range () const { return coords.Range(); }
+    const Point<3> & operator[] (PointIndex pi) const { return coords[pi]; }
+  };
+
+
 
   /**
      Triangle element for surface mesh generation.
   */
+  /**
+     Geometry info of the points of a surface element.
+     The storage is allocated on first write access, elements without
+     geometry info (or where it was dropped after meshing) only keep a
+     null pointer and read zero-initialized geominfo.
+  */
+  class SurfaceGeomInfo
+  {
+    unique_ptr<PointGeomInfo[]> data;
+    static inline const PointGeomInfo no_geominfo[ELEMENT2D_MAXPOINTS] {};
+  public:
+    SurfaceGeomInfo () = default;
+    SurfaceGeomInfo (const SurfaceGeomInfo & gi2) { *this = gi2; }
+    SurfaceGeomInfo (SurfaceGeomInfo &&) = default;
+    SurfaceGeomInfo & operator= (const SurfaceGeomInfo & gi2)
+    {
+      if (!gi2.data)
+        data.reset();
+      else if (&gi2 != this)
+        {
+          auto p = Data();
+          for (int i = 0; i < ELEMENT2D_MAXPOINTS; i++)
+            p[i] = gi2.data[i];
+        }
+      return *this;
+    }
+    SurfaceGeomInfo & operator= (SurfaceGeomInfo &&) = default;
+
+    bool IsAllocated () const { return data != nullptr; }
+    void Clear () { data.reset(); }
+
+    PointGeomInfo * Data ()
+    {
+      if (!data)
+        data = make_unique<PointGeomInfo[]> (ELEMENT2D_MAXPOINTS);
+      return data.get();
+    }
+    const PointGeomInfo * Data () const { return data ? data.get() : no_geominfo; }
+
+    PointGeomInfo & operator[] (int i) { return Data()[i]; }
+    const PointGeomInfo & operator[] (int i) const { return Data()[i]; }
+  };
+
   class Element2d
   { 
     /// point numbers
     PointIndex pnum[ELEMENT2D_MAXPOINTS];
     /// geom info of points
-    PointGeomInfo geominfo[ELEMENT2D_MAXPOINTS];
+    SurfaceGeomInfo geominfo;
 
     /// surface nr
     int index;
@@ -743,8 +806,12 @@ namespace netgen
     auto PNums() const { return FlatArray<const PointIndex> (NP, &pnum[0]); }
     auto Vertices() const { return FlatArray<const PointIndex> (GetNV(), &pnum[0]); }
 
-    auto GeomInfo() const { return FlatArray<const PointGeomInfo> (np, &geominfo[0]); }
-    auto GeomInfo() { return FlatArray<PointGeomInfo> (np, &geominfo[0]); }
+    auto GeomInfo() const { return FlatArray<const PointGeomInfo> (np, geominfo.Data()); }
+    auto GeomInfo() { return FlatArray<PointGeomInfo> (np, geominfo.Data()); }
+    /// geominfo has been set for this element
+    bool HasGeomInfo() const { return geominfo.IsAllocated(); }
+    /// release geominfo, reading it afterwards gives zero geominfo
+    void ClearGeomInfo() { geominfo.Clear(); }
     
     ///
     PointIndex & PNum (int i) { return pnum[i-1]; }
@@ -1614,6 +1681,13 @@ namespace netgen
 
     bool parallel_meshing = true;
     int nthreads = 4;
+    /// mesh independent faces concurrently (only if parallel_meshing is set)
+    bool parallel_surface_meshing = false;
+    /// split the volume mesh of one domain into that many slabs meshed
+    /// concurrently (only if parallel_meshing is set, 0 = off)
+    int parallel_volume_subregions = 0;
+    /// insert Delaunay points in concurrent batches (only if parallel_meshing is set)
+    bool parallel_delaunay = false;
 
     Flags geometrySpecificParameters;
 
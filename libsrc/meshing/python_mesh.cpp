@@ -1224,6 +1224,9 @@ DLL_HEADER void ExportNetgenMeshing(py::module &m)
           {
             return self.Compress ();
           } ,py::call_guard<py::gil_scoped_release>())
+
+    .def ("ClearGeomInfo", &Mesh::ClearGeomInfo,
+          "Release geometry info of surface elements, the mesh cannot be refined or curved afterwards")
           
     .def ("AddRegion", [] (Mesh & self, string name, int dim) -> int
          {
@@ -1493,6 +1496,32 @@ py::arg("point_tolerance") = -1.)
     .def ("BuildSearchTree", &Mesh::BuildElementSearchTree,py::call_guard<py::gil_scoped_release>(),
           py::arg("dim")=3)
 
+    .def ("GetElementsOfPoints", [](Mesh & self, py::buffer b1, double tol)
+          {
+            auto b = b1.cast<py::array_t<double_t, py::array::c_style | py::array::forcecast>>();
+            py::buffer_info info = b.request();
+            if (info.ndim != 2 || info.shape[1] != 3)
+              throw std::runtime_error("GetElementsOfPoints needs array of shape (n,3)");
+            size_t n = info.shape[0];
+            FlatArray<const Point<3>> pts(n, static_cast<const Point<3>*> (info.ptr));
+
+            Array<ElementIndex> els(n);
+            py::array_t<double> lami(std::vector<size_t>{ n, 3 });
+            FlatArray<Vec<3>> lamis(n, reinterpret_cast<Vec<3>*> (lami.mutable_data()));
+            {
+              py::gil_scoped_release release;
+              self.GetElementsOfPoints (pts, els, lamis, tol);
+            }
+
+            py::array_t<int> elnrs(n);
+            auto elnrs_data = elnrs.mutable_data();
+            for (size_t i = 0; i < n; i++)
+              elnrs_data[i] = els[i].IsValid() ? int(els[i] - IndexBASE<ElementIndex>()) : -1;
+            return py::make_tuple(elnrs, lami);
+          }, py::arg("points"), py::arg("tol")=1e-4,
+          "Locate points given as array of shape (n,3) in parallel.\n"
+          "Returns 0-based element numbers (-1 if not found) and local coordinates.")
+
     .def ("BoundaryLayer2", GenerateBoundaryLayer2, py::arg("domain"), py::arg("thicknesses"), py::arg("make_new_domain")=true, py::arg("boundaries")=Array<int>{})
     .def ("BoundaryLayer", [](Mesh & self, variant<string, int, std::vector<int>> boundary,
                               variant<double, std::vector<double>> thickness,
@@ -181,6 +181,12 @@ inline void CreateMPfromKwargs(MeshingParameters& mp, py::kwargs kwargs, bool th
       mp.autozrefine = py::cast<bool>(kwargs.attr("pop")("autozrefine"));
     if(kwargs.contains("parallel_meshing"))
       mp.parallel_meshing = py::cast<bool>(kwargs.attr("pop")("parallel_meshing"));
+    if(kwargs.contains("parallel_surface_meshing"))
+      mp.parallel_surface_meshing = py::cast<bool>(kwargs.attr("pop")("parallel_surface_meshing"));
+    if(kwargs.contains("parallel_volume_subregions"))
+      mp.parallel_volume_subregions = py::cast<int>(kwargs.attr("pop")("parallel_volume_subregions"));
+    if(kwargs.contains("parallel_delaunay"))
+      mp.parallel_delaunay = py::cast<bool>(kwargs.attr("pop")("parallel_delaunay"));
     if(kwargs.contains("nthreads"))
       mp.nthreads = py::cast<int>(kwargs.attr("pop")("nthreads"));
     if(kwargs.contains("closeedgefac"))
@@ -398,7 +398,6 @@ namespace netgen
     (*testout) << "nv   = " << nv << endl;
 
     (*tracer) ("Topology::Update setup tables", false);
-    NgArray<int,PointIndex::BASE> cnt(nv);
 
     /*
       generate:
@@ -433,6 +432,113 @@ namespace netgen
 
     (*tracer) ("Topology::Update setup tables", true);
 
+
+    /*
+      incremental update:
+      An element is unchanged if its local edges still match the stored
+      edge vertices. If only a few elements changed since the last update,
+      only the vertices of the changed elements are processed. Old edges and
+      faces keep their numbers, new ones are numbered in the same order as
+      in a full update.
+    */
+    if (compact_pending && !build_parent_edges && !build_parent_faces)
+      {
+        // retired edges and faces dominate, renumber from scratch
+        edge2vert.SetSize0();
+        face2vert.SetSize0();
+        compact_pending = false;
+      }
+
+    bool incremental = incremental_update && buildvertex2element && buildedges &&
+      !build_parent_edges && !build_parent_faces && ntasks == 1 &&
+      edge2vert.Size() > 0 && nv >= nv_last &&
+      (!buildfaces || (faces.Size() == edges.Size() && surffaces.Size() == surfedges.Size()));
+
+    TBitArray<PointIndex> changed_verts(nv);
+    BitArray changed_els(ne), changed_sels(nse), changed_segs(nseg);
+    Array<PointIndex> update_verts;
+    if (incremental)
+      {
+        static Timer t("Topology::Update find changed elements"); RegionTimer reg(t);
+        changed_verts.Clear();
+        changed_els.Clear();
+        changed_sels.Clear();
+        changed_segs.Clear();
+
+        auto same_edges = [&] (const auto & el, const auto & eledges_old)
+          {
+            auto eledges = MeshTopology::GetEdges (el.GetType());
+            for (int k = 0; k < eledges.Size(); k++)
+              {
+                PointIndices<2> edge = Sort (PointIndices<2>(el[eledges[k][0]], el[eledges[k][1]]));
+                int enr = eledges_old[k];
+                if (enr < 0 || enr >= edge2vert.Size() ||
+                    edge2vert[enr][0] != edge[0] || edge2vert[enr][1] != edge[1])
+                  return false;
+              }
+            return eledges.Size() == eledges_old.size() || int(eledges_old[eledges.Size()]) == -1;
+          };
+        auto mark = [&] (const auto & el, BitArray & changed, size_t i)
+          {
+            changed.SetBitAtomic (i);
+            for (PointIndex v : el.Vertices())
+              changed_verts.SetBitAtomic (v);
+          };
+
+        ParallelFor (ne, [&](size_t i)
+                     {
+                       const Element & el = (*mesh)[ElementIndex(i)];
+                       if (i >= edges.Size() || !same_edges (el, edges[i]))
+                         mark (el, changed_els, i);
+                     });
+        ParallelFor (nse, [&](size_t i)
+                     {
+                       const Element2d & el = (*mesh)[SurfaceElementIndex(i)];
+                       if (i >= surfedges.Size() || !same_edges (el, surfedges[i]))
+                         mark (el, changed_sels, i);
+                     });
+        ParallelFor (nseg, [&](size_t i)
+                     {
+                       const Segment & seg = (*mesh)[SegmentIndex(i)];
+                       PointIndices<2> edge = Sort (PointIndices<2>(seg[0], seg[1]));
+                       int enr = i < segedges.Size() ? int(segedges[i]) : -1;
+                       if (enr < 0 || enr >= edge2vert.Size() ||
+                           edge2vert[enr][0] != edge[0] || edge2vert[enr][1] != edge[1])
+                         mark (seg, changed_segs, i);
+                     });
+
+        // new vertices need the edge between their parents
+        for (PointIndex v = nv_last+IndexBASE<PointIndex>();
+             v < min(nv, int(mesh->mlbetweennodes.Size()))+IndexBASE<PointIndex>(); v++)
+          {
+            PointIndices<2> parents = Sort (mesh->mlbetweennodes[v]);
+            if (parents[0].IsValid() && parents[0] < nv+IndexBASE<PointIndex>())
+              changed_verts.SetBit (parents[0]);
+          }
+
+        for (PointIndex v : Range(nv)+IndexBASE<PointIndex>())
+          if (changed_verts.Test(v))
+            update_verts.Append (v);
+
+        // not worth it, process all vertices
+        if (4*update_verts.Size() > nv)
+          incremental = false;
+        else
+          PrintMessage (5, "Incremental topology update, ", update_verts.Size(), " of ", nv, " vertices changed");
+      }
+
+    // vertices whose edges and faces are (re)numbered
+    size_t nupdate = incremental ? update_verts.Size() : nv;
+    auto update_vertex = [&] (size_t i)
+      {
+        return incremental ? update_verts[i] : PointIndex(i+IndexBASE<PointIndex>());
+      };
+    auto in_update = [&] (PointIndex v)
+      {
+        return !incremental || changed_verts.Test(v);
+      };
+    Array<int> cnt(nupdate);
+
     
     if (buildedges)
       {
@@ -454,68 +560,67 @@ namespace netgen
 	  for (int j = 0; j < 4; j++)
 	    surfedges[i][j].nr = -1;
         */
-        ParallelFor (ne, [this](auto i)
+        ParallelFor (ne, [&](auto i)
                      {
-                       for (auto & e : edges[i])
-                         e = -1;
+                       if (!incremental || changed_els.Test(i))
+                         for (auto & e : edges[i])
+                           e = -1;
                      });
-	ParallelFor (nse, [this](auto i)
+	ParallelFor (nse, [&](auto i)
                      {
-                       for (auto & e : surfedges[i])
-                         e = -1;
+                       if (!incremental || changed_sels.Test(i))
+                         for (auto & e : surfedges[i])
+                           e = -1;
                      });
 
 
         
 	// keep existing edges
-	cnt = 0;
-	for (int i = 0; i < edge2vert.Size(); i++)
-	  cnt[edge2vert[i][0]]++;
-	TABLE<int,PointIndex::BASE> vert2edge (cnt);
-	for (int i = 0; i < edge2vert.Size(); i++)
-	  vert2edge.AddSave (edge2vert[i][0], i);
+        static Timer tvert2edge("topology::buildedges - vertex tables");
+        tvert2edge.Start();
+        auto vert2edge = ngcore::CreateSortedTable<int, PointIndex>
+          (edge2vert.Range(),
+           [&](auto & table, int i)
+           {
+             if (in_update (edge2vert[i][0]))
+               table.Add (edge2vert[i][0], i);
+           }, nv);
 
 	// ensure all coarse grid and intermediate level edges
-	cnt = 0;
-	// for (int i = mesh->mlbetweennodes.Begin(); i < mesh->mlbetweennodes.End(); i++)
-        for (int i : mesh->mlbetweennodes.Range())
-	  {
-	    PointIndices<2> parents = Sort (mesh->mlbetweennodes[i]);
-	    if (parents[0].IsValid()) cnt[parents[0]]++;
-	  }
-	TABLE<int,PointIndex::BASE> vert2vertcoarse (cnt);
-	// for (int i = mesh->mlbetweennodes.Begin(); i < mesh->mlbetweennodes.End(); i++)
-        for (int i : mesh->mlbetweennodes.Range())
-	  {
-	    PointIndices<2> parents = Sort (mesh->mlbetweennodes[i]);
-	    if (parents[0].IsValid()) vert2vertcoarse.AddSave (parents[0], parents[1]);
-	  }
-
-
-
-	int max_edge_on_vertex = 0;
-	for (int i = PointIndex::BASE; i < nv+PointIndex::BASE; i++)
-	  {
-	    int onv = vert2edge[i].Size() + vert2vertcoarse[i].Size() +
-              4*(vert2element)[i].Size() + 2*(vert2surfelement)[i].Size() + (vert2segment)[i].Size();
-	    max_edge_on_vertex = max (onv, max_edge_on_vertex);
-	  }
-
+        auto vert2vertcoarse = ngcore::CreateSortedTable<PointIndex, PointIndex>
+          (mesh->mlbetweennodes.Range(),
+           [&](auto & table, PointIndex i)
+           {
+             PointIndices<2> parents = Sort (mesh->mlbetweennodes[i]);
+             if (parents[0].IsValid() && parents[0] < nv+IndexBASE<PointIndex>() &&
+                 in_update (parents[0]))
+               table.Add (parents[0], parents[1]);
+           }, nv);
+
+	int max_edge_on_vertex = ngcore::ParallelReduce
+          (nupdate, [&](size_t i)
+           {
+             PointIndex v = update_vertex(i);
+             return int(vert2edge[v].Size() + vert2vertcoarse[v].Size() +
+                        4*vert2element[v].Size() + 2*vert2surfelement[v].Size() + vert2segment[v].Size());
+           },
+           [](int a, int b) { return max(a,b); }, 0);
+        tvert2edge.Stop();
         
         // count edges associated with vertices
+        static Timer tcount("topology::buildedges - count");
+        tcount.Start();
         cnt = 0;
 
         ParallelForRange
-          (mesh->GetNV(), // Points().Size(),
+          (nupdate,
            [&] (IntRange r)
            {
-             auto begin = r.First();
-             auto end = r.Next();
              // INDEX_CLOSED_HASHTABLE<int> v2eht(2*max_edge_on_vertex+10);
              ngcore::ClosedHashTable<int, int> v2eht(2*max_edge_on_vertex+10);
-             for (PointIndex v = begin+IndexBASE<PointIndex>();
-                  v < end+IndexBASE<PointIndex>(); v++)
+             for (size_t i : r)
                {
+                 PointIndex v = update_vertex(i);
                  v2eht.DeleteData();
                  for (int ednr : vert2edge[v])
                    {
@@ -534,17 +639,20 @@ namespace netgen
                                   v2eht.Set (edge[1], 33); // something                                  
                                 });
                  
-                 cnt[v] = v2eht.UsedElements()-usedold;
+                 cnt[i] = v2eht.UsedElements()-usedold;
                }
            }, TasksPerThread(4) );
+        tcount.Stop();
 
         // accumulate number of edges
+        static Timer tnumber("topology::buildedges - numbering");
+        tnumber.Start();
         int ned = edge2vert.Size();
 
-        for (size_t v : cnt.Range())
+        for (size_t i : cnt.Range())
           {
-            auto hv = cnt[v];
-            cnt[v] = ned;
+            auto hv = cnt[i];
+            cnt[i] = ned;
             ned += hv;
           }
         edge2vert.SetSize(ned);
@@ -556,19 +664,17 @@ namespace netgen
 	// for (PointIndex v = IndexBASE<PointIndex>(); v < nv+IndexBASE<PointIndex>(); v++)
 
         ParallelForRange
-          (mesh->GetNV(), // Points().Size(),
+          (nupdate,
            [&] (IntRange r)
            {
-             auto begin = r.First();
-             auto end = r.Next();
              // INDEX_CLOSED_HASHTABLE<int> v2eht(2*max_edge_on_vertex+10);
              ngcore::ClosedHashTable<int, int> v2eht(2*max_edge_on_vertex+10);
 
              Array<int> vertex2;
-             for (PointIndex v = begin+IndexBASE<PointIndex>();
-                  v < end+IndexBASE<PointIndex>(); v++)
+             for (size_t i : r)
                {
-                 int ned = cnt[v];
+                 PointIndex v = update_vertex(i);
+                 int ned = cnt[i];
                  v2eht.DeleteData();            
                  vertex2.SetSize0 ();
                  
@@ -641,34 +747,41 @@ namespace netgen
                }
            }, TasksPerThread(4) );
 
+        // segments of unchanged vertices, the last segment wins as in the full update
+        if (incremental)
+          for (SegmentIndex si : Range(nseg))
+            edge2segment[segedges[si]] = si;
+        tnumber.Stop();
+
 
         if (build_parent_edges)
         {
           static Timer t("build_hierarchy"); RegionTimer reg(t);
-          cnt = 0;
-          for (auto verts : edge2vert) cnt[verts[0]]++;
-          TABLE<int,PointIndex::BASE> vert2edge (cnt);
-          for (auto i : edge2vert.Range())
-            vert2edge.AddSave (edge2vert[i][0], i);
+          auto vert2edge = ngcore::CreateSortedTable<int, PointIndex>
+            (edge2vert.Range(),
+             [&](auto & table, int i)
+             {
+               table.Add (edge2vert[i][0], i);
+             }, nv);
 
           // build edge hierarchy:
           parent_edges.SetSize (ned);
           parent_edges = { -1, { -1, -1, -1 } };
 
-          for (size_t i = 0; i < ned; i++)
+          ParallelFor (ned, [&](size_t i)
           {
             auto verts = edge2vert[i];  // 2 vertices of edge
 
             if (verts[0] >= mesh->mlbetweennodes.Size()+IndexBASE<PointIndex>() ||
                 verts[1] >= mesh->mlbetweennodes.Size()+IndexBASE<PointIndex>())
-              continue;
+              return;
 
             auto pa0 = mesh->mlbetweennodes[verts[0]]; // two parent vertices of v0
             auto pa1 = mesh->mlbetweennodes[verts[1]]; // two parent vertices of v1
 
             // both vertices are on coarsest mesh
             if (!pa0[0].IsValid() && !pa1[0].IsValid())
-              continue;
+              return;
 
             int issplitedge = 0;
             if (pa0[0] == verts[1] || pa0[1] == verts[1])
@@ -751,7 +864,9 @@ namespace netgen
 
               if (!bisect_edge) // not a bisect edge (then a red edge)
               {
-                IVec<2,PointIndex> paedge1, paedge2, paedge3;
+                // paedge3 stays invalid if the parent edges have no common vertex
+                IVec<2,PointIndex> paedge1, paedge2;
+                IVec<2,PointIndex> paedge3(PointIndex::INVALID, PointIndex::INVALID);
                 int orient1 = 0, orient2 = 0, orient3=0;
                 // int orient_inner = 0;
                 paedge1 = IVec<2,PointIndex> (pa0[0], pa0[1]);
@@ -810,9 +925,10 @@ namespace netgen
                   if (auto cverts = edge2vert[ednr]; cverts[1] == paedge2[1])
                     paedgenr2 = ednr;
 
-                for (int ednr : vert2edge[paedge3[0]])
-                  if (auto cverts = edge2vert[ednr]; cverts[1] == paedge3[1])
-                    paedgenr3 = ednr;
+                if (paedge3[0].IsValid())
+                  for (int ednr : vert2edge[paedge3[0]])
+                    if (auto cverts = edge2vert[ednr]; cverts[1] == paedge3[1])
+                      paedgenr3 = ednr;
 
                 parent_edges[i] = { 8+orient1+2*orient2+4*orient3, { paedgenr1, paedgenr2, paedgenr3 } };
 
@@ -894,7 +1010,7 @@ namespace netgen
               */
             }
 
-          }
+          });
 
           /*
              for (int i : Range(parent_edges))
@@ -938,62 +1054,28 @@ namespace netgen
 	surffaces.SetSize(nse);
   
 
-	cnt = 0;
-	for (int i = 0; i < face2vert.Size(); i++)
-	  cnt[face2vert[i][0]]++;
-	TABLE<int,PointIndex::BASE> vert2oldface(cnt);
-	for (int i = 0; i < face2vert.Size(); i++)
-	  vert2oldface.AddSave (face2vert[i][0], i);
+        static Timer tvert2face("topology::buildfaces - vertex tables");
+        tvert2face.Start();
+        auto vert2oldface = ngcore::CreateSortedTable<int, PointIndex>
+          (face2vert.Range(),
+           [&](auto & table, int i)
+           {
+             if (in_update (face2vert[i][0]))
+               table.Add (face2vert[i][0], i);
+           }, nv);
 
         // find all potential intermediate faces
         Array<IVec<3>> intermediate_faces;
         if (build_parent_faces)
           {
-            for (ElementIndex ei = 0; ei < ne; ei++)
-              for (int i = 0; i < 4; i++)
-                {
-                  Element2d face;
-                  // cout << "element: " << (*mesh)[ei].PNums() << endl;
-                  (*mesh)[ei].GetFace(i+1, face);
-                  // cout << "face " << face.PNums() << endl;
-                  IVec<3,PointIndex> f3 = { face[0], face[1], face[2] };
-                  for (int j = 0; j < 3; j++)
-                    {
-                      PointIndex v = f3[j];
-                      if (v >= mesh->mlbetweennodes.Size()+IndexBASE<PointIndex>())
-                        continue;
-
-                      auto pa = mesh->mlbetweennodes[v];
-                      for (int k = 0; k < 2; k++)
-                        if (f3.Contains(pa[k]))
-                          {
-                            PointIndex v0 = pa[k]; // also in face
-                            PointIndex v1 = pa[1-k];
-                            PointIndex v2 = f3[0]-v+f3[1]-v0+f3[2];
-                            // if there is an edge connecting v1 and v2, accept
-                            // the new face
-                            IVec<2> parentedge(v1, v2);
-                            parentedge.Sort();
-                            if (v2e.Used(parentedge)){ 
-                              IVec<3> cf3 = { v0, v1, v2 };
-                              cf3.Sort();
-                              // cout << "intermediate: " << cf3 << " of " << f3 << endl;
-                              intermediate_faces.Append (cf3);
-                            }
-                          }
-                    }
-                }
-
-            for (SurfaceElementIndex sei = 0; sei < nse; sei++)
+            auto intermediate = [&] (IVec<3,PointIndex> f3, auto func)
               {
-                const Element2d & sel = (*mesh)[sei];
-                IVec<3,PointIndex> f3 = { sel[0], sel[1], sel[2] };
                 for (int j = 0; j < 3; j++)
                   {
                     PointIndex v = f3[j];
                     if (v >= mesh->mlbetweennodes.Size()+IndexBASE<PointIndex>())
                       continue;
-                    
+
                     auto pa = mesh->mlbetweennodes[v];
                     for (int k = 0; k < 2; k++)
                       if (f3.Contains(pa[k]))
@@ -1009,36 +1091,78 @@ namespace netgen
                             IVec<3> cf3 = { v0, v1, v2 };
                             cf3.Sort();
                             // cout << "intermediate: " << cf3 << " of " << f3 << endl;
-                            intermediate_faces.Append (cf3);
+                            func (cf3);
                           }
                         }
                   }
-              }
+              };
+            
+            // faces 0..4*ne from volume elements, then surface elements
+            auto loop_faces = [&] (size_t i, auto func)
+              {
+                if (i < ne)
+                  {
+                    ElementIndex ei(i);
+                    for (int k = 0; k < 4; k++)
+                      {
+                        Element2d face;
+                        (*mesh)[ei].GetFace(k+1, face);
+                        intermediate ({ face[0], face[1], face[2] }, func);
+                      }
+                  }
+                else
+                  {
+                    const Element2d & sel = (*mesh)[SurfaceElementIndex(i-ne)];
+                    intermediate ({ sel[0], sel[1], sel[2] }, func);
+                  }
+              };
 
+            // count, then fill in element order to keep the numbering deterministic
+            Array<int> first_intermediate(ne+nse);
+            ParallelFor (ne+nse, [&](size_t i)
+                         {
+                           int n = 0;
+                           loop_faces (i, [&](IVec<3>) { n++; });
+                           first_intermediate[i] = n;
+                         });
+            int ninter = 0;
+            for (auto & fi : first_intermediate)
+              {
+                int hv = fi;
+                fi = ninter;
+                ninter += hv;
+              }
+            intermediate_faces.SetSize (ninter);
+            ParallelFor (ne+nse, [&](size_t i)
+                         {
+                           int pos = first_intermediate[i];
+                           loop_faces (i, [&](IVec<3> cf3) { intermediate_faces[pos++] = cf3; });
+                         });
           }
-	cnt = 0;
-	for (int i = 0; i < intermediate_faces.Size(); i++)
-	  cnt[intermediate_faces[i][0]]++;
-	TABLE<int,PointIndex::BASE> vert2intermediate(cnt);
-	for (int i = 0; i < intermediate_faces.Size(); i++)
-	  vert2intermediate.AddSave (intermediate_faces[i][0], i);
-        // cout << "vert2intermediate = " << endl << vert2intermediate << endl;
-
-        
-	for (int elnr = 0; elnr < ne; elnr++)
-	  for (int j = 0; j < 6; j++)
-	    faces[elnr][j] = -1;
-	
 
-	int max_face_on_vertex = 0;
-	for (PointIndex i = IndexBASE<PointIndex>(); i < nv+IndexBASE<PointIndex>(); i++)
-	  {
-	    int onv = vert2oldface[i].Size() + vert2element[i].Size() + vert2surfelement[i].Size();
-	    max_face_on_vertex = max (onv, max_face_on_vertex);
-	  }
-	
+        auto vert2intermediate = ngcore::CreateSortedTable<int, PointIndex>
+          (intermediate_faces.Range(),
+           [&](auto & table, int i)
+           {
+             table.Add (intermediate_faces[i][0], i);
+           }, nv);
+        // cout << "vert2intermediate = " << endl << vert2intermediate << endl;
 
+        ParallelFor (ne, [&](auto i)
+                     {
+                       if (!incremental || changed_els.Test(i))
+                         for (auto & f : faces[i])
+                           f = -1;
+                     });
 
+	int max_face_on_vertex = ngcore::ParallelReduce
+          (nupdate, [&](size_t i)
+           {
+             PointIndex v = update_vertex(i);
+             return int(vert2oldface[v].Size() + vert2element[v].Size() + vert2surfelement[v].Size());
+           },
+           [](int a, int b) { return max(a,b); }, 0);
+        tvert2face.Stop();
 
         // NgProfiler::StopTimer (timer2a);
         // NgProfiler::StartTimer (timer2b);
@@ -1048,21 +1172,20 @@ namespace netgen
 	int oldnfa = face2vert.Size();
 
         // count faces associated with vertices
+        static Timer tcount("topology::buildfaces - count");
+        tcount.Start();
         cnt = 0;
         // for (auto v : mesh.Points().Range())
         // NgProfiler::StartTimer (timer2b1);
         ParallelForRange
-          (mesh->GetNV(), // Points().Size(),
+          (nupdate,
            [&] (IntRange r)
             {
-              // auto begin = r.First();
-              // auto end = r.Next();
               // INDEX_3_CLOSED_HASHTABLE<int> vert2face(2*max_face_on_vertex+10);
               NgClosedHashTable<INDEX_3, int> vert2face(2*max_face_on_vertex+10);
-              // for (PointIndex v = begin+PointIndex::BASE;
-              // v < end+PointIndex::BASE; v++)
-              for (PointIndex v : r+PointIndex::BASE)                
+              for (size_t i : r)
                 {
+                  PointIndex v = update_vertex(i);
                   vert2face.DeleteData();
                   
                   for (int j = 0; j < vert2oldface[v].Size(); j++)
@@ -1098,39 +1221,37 @@ namespace netgen
                                        vert2face.Set (face, 33); // something
                                      }
                                  });
-                  cnt[v] = cnti;
+                  cnt[i] = cnti;
                 }
             }, TasksPerThread(4) );
+        tcount.Stop();
         // NgProfiler::StopTimer (timer2b1);
         
         // accumulate number of faces
+        static Timer tnumber("topology::buildfaces - numbering");
+        tnumber.Start();
         int nfa = oldnfa;
         // for (auto v : Range(mesh->GetNV())) // Points().Range())
         // for (size_t v = 0; v < mesh->GetNV(); v++)
-        for (auto v : cnt.Range())
+        for (auto i : cnt.Range())
           {
-            auto hv = cnt[v];
-            cnt[v] = nfa;
+            auto hv = cnt[i];
+            cnt[i] = nfa;
             nfa += hv;
           }
         face2vert.SetSize(nfa);
         
 
         ParallelForRange
-          (mesh->GetNV(),
+          (nupdate,
            [&] (IntRange r)
             {
-              // auto begin = r.First();
-              // auto end = r.Next();
               // INDEX_3_CLOSED_HASHTABLE<int> vert2face(2*max_face_on_vertex+10);
               NgClosedHashTable<INDEX_3, int> vert2face(2*max_face_on_vertex+10);
-              /*
-              for (PointIndex v = begin+PointIndex::BASE;
-                   v < end+PointIndex::BASE; v++)
-              */
-              for (PointIndex v : r+PointIndex::BASE)
+              for (size_t i : r)
                 {
-                  int first_fa = cnt[v];
+                  PointIndex v = update_vertex(i);
+                  int first_fa = cnt[i];
                   int nfa = first_fa;
                   vert2face.DeleteData();
                   
@@ -1218,6 +1339,7 @@ namespace netgen
                                  });
                 }
             }, TasksPerThread(4) );
+        tnumber.Stop();
         
 
 	// *testout << "face2vert = " << endl << face2vert << endl;
@@ -1226,10 +1348,14 @@ namespace netgen
         // NgProfiler::StartTimer (timer2c);
 
 
+        static Timer tsurf2vol("topology::buildfaces - surf2vol");
+        tsurf2vol.Start();
 	face2surfel.SetSize (nfa);
 	face2surfel = SurfaceElementIndex::INVALID;
-	for (SurfaceElementIndex sei = 0; sei < nse; sei++)
-	  face2surfel[GetFace(sei)] = sei;
+        ParallelFor (nse, [this](SurfaceElementIndex sei)
+                     {
+                       face2surfel[GetFace(sei)] = sei;
+                     });
 
 	/*
 	  cout << "build table complete" << endl;
@@ -1256,12 +1382,22 @@ namespace netgen
                            int fnum = faces[i][j];
                            if (fnum >= 0 && face2surfel[fnum].IsValid())
                              {
+                               // first element claims slot 0, the second one goes to slot 1
                                SurfaceElementIndex sel = face2surfel[fnum];
-                               surf2volelement[sel][1] = surf2volelement[sel][0];
-                               surf2volelement[sel][0] = i; // +1;
+                               ElementIndex expected = ElementIndex::INVALID;
+                               if (!AsAtomic(surf2volelement[sel][0]).compare_exchange_strong (expected, ElementIndex(i)))
+                                 surf2volelement[sel][1] = i;
                              }
                          }});
+        // same order as the sequential loop: larger element number first
+        ParallelFor (nse, [this](auto sei)
+                     {
+                       auto & s2v = surf2volelement[sei];
+                       if (s2v[1].IsValid() && s2v[1] > s2v[0])
+                         Swap (s2v[0], s2v[1]);
+                     });
         (*tracer) ("Topology::Update build surf2vol", true);        
+        tsurf2vol.Stop();
 
 	face2vert.SetAllocSize (face2vert.Size());
 
@@ -1300,15 +1436,22 @@ namespace netgen
 	for (int i = 1; i <= nse; i++)
 	  face_surfels[GetSurfaceElementFace1 (i)-1]++;
         */
-        for (auto sei : Range(mesh->SurfaceElements()))
-	  face_surfels[GetFace(sei)]++;          
+        ParallelFor (Range(mesh->SurfaceElements()), [&](auto sei)
+                     {
+                       AsAtomic(face_surfels[GetFace(sei)])++;
+                     });
         (*tracer) ("Topology::Update count face_els", true);
 
 
+        static Timer tcheck("topology::buildfaces - check");
+        tcheck.Start();
 	if (ne)
 	  {
-	    int cnt_err = 0;
-	    for (int i = 0; i < nfa; i++)
+            // count in parallel, report illegal faces only if there are any
+	    int cnt_err = ngcore::ParallelReduce
+              (nfa, [&](size_t i) { return int(face_els[i] + face_surfels[i] == 1); },
+               [](int a, int b) { return a+b; }, 0);
+	    for (int i = 0; cnt_err && i < nfa; i++)
 	      {
 		/*
 		  (*testout) << "face " << i << " has " << int(face_els[i]) << " els, " 
@@ -1317,7 +1460,6 @@ namespace netgen
 		*/
 		if (face_els[i] + face_surfels[i] == 1)
 		  {
-		    cnt_err++;
 #ifdef PARALLEL
 		    if ( ntasks > 1 )
 		      {
@@ -1366,6 +1508,7 @@ namespace netgen
 	    if (cnt_err && ntasks == 1)
 	      cout << IM(5) << cnt_err << " elements are not matching !!!" << endl;
 	  }
+        tcheck.Stop();
         // NgProfiler::StopTimer (timer2c);
 
 
@@ -1377,21 +1520,24 @@ namespace netgen
 
             // cout << "f2v = " << face2vert << endl;
             
-            ngcore::ClosedHashTable<IVec<3>, int> v2f(nv);
+            static Timer t("build_face_hierarchy"); RegionTimer reg(t);
+            ngcore::ClosedHashTable<IVec<3>, int> v2f_table(nv);
             for (auto i : Range(face2vert))
               {
                 auto face = face2vert[i];
                 IVec<3> f3(face[0], face[1], face[2]);
                 f3.Sort();
-                v2f[f3] = i;
+                v2f_table[f3] = i;
               }
+            // only lookups from here on, the const access is thread-safe
+            const auto & v2f = v2f_table;
 
             // cout << "v2f:" << endl << v2f << endl;
             
             parent_faces.SetSize (nfa);
             parent_faces = { -1, { -1, -1, -1, -1 } };
 
-            for (auto i : Range(nfa))
+            ParallelFor (nfa, [&](size_t i)
               {
                 IVec<3,PointIndex> f3(face2vert[i][0], face2vert[i][1], face2vert[i][2]);
 
@@ -1407,7 +1553,7 @@ namespace netgen
                     if (parents[0] >= IndexBASE<PointIndex>())
                       all_vert_coarse = false;
                   }
-                if (all_vert_coarse) continue;
+                if (all_vert_coarse) return;
 
                 
                 
@@ -1665,7 +1811,7 @@ namespace netgen
                     }
                   }
                 }
-              }
+              });
           }
       }
     
@@ -1703,6 +1849,43 @@ namespace netgen
        *testout << endl; 
        }
     */
+
+    if (incremental)
+      {
+        // retired edges and faces stay in the tables to keep the numbering,
+        // compact lazily once they are the majority
+        BitArray used_edges(edge2vert.Size());
+        used_edges.Clear();
+        ParallelFor (ne, [&](auto i)
+                     {
+                       for (int ed : edges[i])
+                         if (ed >= 0) used_edges.SetBitAtomic(ed);
+                     });
+        ParallelFor (nse, [&](auto i)
+                     {
+                       for (int ed : surfedges[i])
+                         if (ed >= 0) used_edges.SetBitAtomic(ed);
+                     });
+        for (int ed : segedges)
+          used_edges.SetBit(ed);
+        compact_pending = 2*used_edges.NumSet() < edge2vert.Size();
+
+        if (buildfaces)
+          {
+            BitArray used_faces(face2vert.Size());
+            used_faces.Clear();
+            ParallelFor (ne, [&](auto i)
+                         {
+                           for (int fa : faces[i])
+                             if (fa >= 0) used_faces.SetBitAtomic(fa);
+                         });
+            for (int fa : surffaces)
+              used_faces.SetBit(fa);
+            if (2*used_faces.NumSet() < face2vert.Size())
+              compact_pending = true;
+          }
+      }
+    nv_last = nv;
     timestamp = NextTimeStamp();
   }
 
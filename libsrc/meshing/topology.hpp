@@ -63,6 +63,10 @@ class MeshTopology
   Table<SegmentIndex,PointIndex> vert2segment;
   Table<int,PointIndex> vert2pointelement;
   int timestamp;
+  // incremental update: vertices at the last update, renumber at the next one
+  int nv_last = 0;
+  bool incremental_update = true;
+  bool compact_pending = false;
 public:
   MeshTopology () = default;
   MeshTopology (MeshTopology && top) = default;
@@ -75,12 +79,15 @@ public:
   void SetBuildFaces (bool bf) { buildfaces = bf; }
   void SetBuildParentEdges (bool bh) { build_parent_edges = bh; }
   void SetBuildParentFaces (bool bh) { build_parent_faces = bh; }
+  // only renumber around changed elements if few of them changed
+  void SetIncrementalUpdate (bool inc) { incremental_update = inc; }
 
   DLL_HEADER void EnableTable (string name, bool set);
   static void EnableTableStatic (string name, bool set);
 
   bool HasEdges () const  { return buildedges; }
   bool HasFaces () const  { return buildfaces; }
+  bool HasVertex2Element () const { return buildvertex2element; }
   bool HasParentEdges () const { return build_parent_edges; }
 
   void Update(NgTaskManager tm = &DummyTaskManager, NgTracer tracer = &DummyTracer);
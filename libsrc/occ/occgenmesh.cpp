@@ -77,8 +77,11 @@ namespace netgen
 
 
 
+  // restrictions are collected with RestrictLocalHConcurrent, key
+  // orders them (see LocalH::SetHConcurrent)
   void RestrictHTriangle (gp_Pnt2d & par0, gp_Pnt2d & par1, gp_Pnt2d & par2,
-                          BRepLProp_SLProps * prop, BRepLProp_SLProps * prop2, Mesh & mesh, int depth, double h, int layer, const MeshingParameters & mparam)
+                          BRepLProp_SLProps * prop, BRepLProp_SLProps * prop2, Mesh & mesh, int depth, double h, int layer, const MeshingParameters & mparam,
+                          size_t key)
   {
     int ls = -1;
 
@@ -189,20 +192,20 @@ namespace netgen
         if(ls == 0)
           {
             pm.SetX(0.5*(par1.X()+par2.X())); pm.SetY(0.5*(par1.Y()+par2.Y()));
-            RestrictHTriangle(pm, par2, par0, prop, prop2, mesh, depth+1, h, layer, mparam);
-            RestrictHTriangle(pm, par0, par1, prop, prop2, mesh, depth+1, h, layer, mparam);
+            RestrictHTriangle(pm, par2, par0, prop, prop2, mesh, depth+1, h, layer, mparam, key);
+            RestrictHTriangle(pm, par0, par1, prop, prop2, mesh, depth+1, h, layer, mparam, key);
           }
         else if(ls == 1)
           {
             pm.SetX(0.5*(par0.X()+par2.X())); pm.SetY(0.5*(par0.Y()+par2.Y()));
-            RestrictHTriangle(pm, par1, par2, prop, prop2, mesh, depth+1, h, layer, mparam);
-            RestrictHTriangle(pm, par0, par1, prop, prop2, mesh, depth+1, h, layer, mparam);
+            RestrictHTriangle(pm, par1, par2, prop, prop2, mesh, depth+1, h, layer, mparam, key);
+            RestrictHTriangle(pm, par0, par1, prop, prop2, mesh, depth+1, h, layer, mparam, key);
           }
         else if(ls == 2)
           {
             pm.SetX(0.5*(par0.X()+par1.X())); pm.SetY(0.5*(par0.Y()+par1.Y()));
-            RestrictHTriangle(pm, par1, par2, prop, prop2, mesh, depth+1, h, layer, mparam);
-            RestrictHTriangle(pm, par2, par0, prop, prop2, mesh, depth+1, h, layer, mparam);
+            RestrictHTriangle(pm, par1, par2, prop, prop2, mesh, depth+1, h, layer, mparam, key);
+            RestrictHTriangle(pm, par2, par0, prop, prop2, mesh, depth+1, h, layer, mparam, key);
           }
 
       }
@@ -214,16 +217,16 @@ namespace netgen
         prop->SetParameters (parmid.X(), parmid.Y());
         pnt = prop->Value();
         p3d = Point3d(pnt.X(), pnt.Y(), pnt.Z());
-        mesh.RestrictLocalH (p3d, h, layer);
+        mesh.RestrictLocalHConcurrent (p3d, h, key, layer);
 
         p3d = Point3d(pnt0.X(), pnt0.Y(), pnt0.Z());
-        mesh.RestrictLocalH (p3d, h, layer);
+        mesh.RestrictLocalHConcurrent (p3d, h, key, layer);
 
         p3d = Point3d(pnt1.X(), pnt1.Y(), pnt1.Z());
-        mesh.RestrictLocalH (p3d, h, layer);
+        mesh.RestrictLocalHConcurrent (p3d, h, key, layer);
 
         p3d = Point3d(pnt2.X(), pnt2.Y(), pnt2.Z());
-        mesh.RestrictLocalH (p3d, h, layer);
+        mesh.RestrictLocalHConcurrent (p3d, h, key, layer);
 
         //(*testout) << "p = " << p3d << ", h = " << h << ", maxside = " << maxside << endl;
 
@@ -584,16 +587,22 @@ namespace netgen
 
         multithread.task = "Setting local mesh size (edge curvature)";
 
+        // curvature of edges and faces is sampled in parallel, every
+        // thread evaluates with its own adaptors
+        RegionTaskManager rtm(mparam.parallel_meshing ? mparam.nthreads : 0);
+        for(auto layer : Range(1, maxlayer+1))
+          mesh.BeginRestrictLocalH(layer);
+
         // setting edge curvature
 
         int nsections = 20;
 
-        for (int i = 1; i <= nedges && !multithread.terminate; i++)
+        ParallelFor (Range(1, nedges+1), [&] (int i)
           {
+            if (multithread.terminate) return;
             double maxcur = 0;
-            multithread.percent = 100 * (i-1)/double(nedges);
             TopoDS_Edge edge = TopoDS::Edge (geom.emap(i));
-            if (BRep_Tool::Degenerated(edge)) continue;
+            if (BRep_Tool::Degenerated(edge)) return;
             double s0, s1;
             Handle(Geom_Curve) c = BRep_Tool::Curve(edge, s0, s1);
             BRepAdaptor_Curve brepc(edge);
@@ -614,9 +623,9 @@ namespace netgen
 
                 gp_Pnt pnt = c->Value (s);
 
-                mesh.RestrictLocalH (Point3d(pnt.X(), pnt.Y(), pnt.Z()), ComputeH (fabs(curvature), mparam), layer);
+                mesh.RestrictLocalHConcurrent (Point3d(pnt.X(), pnt.Y(), pnt.Z()), ComputeH (fabs(curvature), mparam), i, layer);
               }
-          }
+          });
 
         multithread.task = "Setting local mesh size (face curvature)";
 
@@ -625,9 +634,10 @@ namespace netgen
         int nfaces = geom.fmap.Extent();
 
         BuildTriangulation(geom.shape);
-        for (int i = 1; i <= nfaces && !multithread.terminate; i++)
+
+        ParallelFor (Range(1, nfaces+1), [&] (int i)
           {
-            multithread.percent = 100 * (i-1)/double(nfaces);
+            if (multithread.terminate) return;
             TopoDS_Face face = TopoDS::Face(geom.fmap(i));
             TopLoc_Location loc;
             Handle(Geom_Surface) surf = BRep_Tool::Surface (face);
@@ -670,10 +680,13 @@ namespace netgen
                 //maxside = max (maxside, p[1].Distance(p[2]));
                 //cout << "\rFace " << i << " pos11 ntriangles " << ntriangles << " maxside " << maxside << flush;
 
-                RestrictHTriangle (par[0], par[1], par[2], &prop, &prop2, mesh, 0, 0, layer, mparam);
+                RestrictHTriangle (par[0], par[1], par[2], &prop, &prop2, mesh, 0, 0, layer, mparam, nedges+i);
                 //cout << "\rFace " << i << " pos12 ntriangles " << ntriangles << flush;
               }
-          }
+          });
+
+        for(auto layer : Range(1, maxlayer+1))
+          mesh.EndRestrictLocalH(layer);
 
         // setting close edges
 
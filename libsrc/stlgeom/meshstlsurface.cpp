@@ -607,11 +607,15 @@ int STLSurfaceMeshing (STLGeometry & geom, class Mesh & mesh, const MeshingParam
 
 
 
-void STLSurfaceMeshing1 (STLGeometry & geom,
-			 Mesh & mesh,
-                         const MeshingParameters& mparam,
-			 int retrynr,
-                         const STLParameters& stlparam)
+// mesh face fnr from the open segments of mesh into fmesh. For serial
+// meshing fmesh is the mesh itself. compress is reset afterwards
+static void STLMeshFace (STLGeometry & geom, Mesh & mesh, Mesh & fmesh,
+                         const MeshingParameters& mparam, int fnr,
+                         NgFlatArray<int> segs,
+                         const NgArray<PointIndex> & imeshsp,
+                         const NgArray<int> & ispiral_point,
+                         NgArray<int,PointIndex::BASE> & compress,
+                         double starttime, int retrynr)
 {
   static int timer1 = NgProfiler::CreateTimer ("STL surface meshing1");
   static int timer1a = NgProfiler::CreateTimer ("STL surface meshing1a");
@@ -621,14 +625,148 @@ void STLSurfaceMeshing1 (STLGeometry & geom,
 
   double h = mparam.maxh;
 
+  NgProfiler::StartTimer (timer1);
+  NgProfiler::StartTimer (timer1a);
+
+
+  PrintMessage(5,"Meshing surface ", fnr, "/", mesh.GetNFD());
+  MeshingSTLSurface meshing (geom, mparam);
+  meshing.SetStartTime (starttime);
+
+  // compress = 0;
+  NgArray<PointIndex> icompress;
+  int cntused = 0;
+
+  for (int i = 0; i < imeshsp.Size(); i++)
+    {
+      compress[imeshsp[i]] = ++cntused;
+      icompress.Append(imeshsp[i]);
+    }
+
+  NgProfiler::StopTimer (timer1a);
+  NgProfiler::StartTimer (timer1b);
+
+
+
+  /*
+  for (int i = 1; i <= mesh.GetNOpenSegments(); i++)
+    {
+      const Segment & seg = mesh.GetOpenSegment (i);
+      if (seg.si == fnr)
+        for (int j = 0; j < 2; j++)
+          if (compress[seg[j]] == 0)
+            {
+              compress[seg[j]] = ++cntused;
+              icompress.Append(seg[j]);
+            }
+    }
+  */
+  for (int hi = 0; hi < segs.Size(); hi++)
+    {
+      int i = segs[hi];
+      const Segment & seg = mesh.GetOpenSegment (i);
+      for (int j = 0; j < 2; j++)
+        if (compress[seg[j]] == 0)
+          {
+            compress[seg[j]] = ++cntused;
+            icompress.Append(seg[j]);
+          }
+    }
+
+  NgProfiler::StopTimer (timer1b);
+  NgProfiler::StartTimer (timer1c);
+
+
+  for (int hi = 0; hi < icompress.Size(); hi++)
+    {
+      PointIndex pi = icompress[hi];
+
+      /*
+      // int sppointnum = meshsp.Get(i);
+      int sppointnum = 0;
+      if (hi < ispiral_point.Size())
+        sppointnum = ispiral_point[hi];
+
+      if (sppointnum)
+        {
+      */
+      if (hi < ispiral_point.Size())
+        {
+          int sppointnum = ispiral_point[hi];
+
+          MultiPointGeomInfo mgi;
+
+          int ntrigs = geom.NOTrigsPerPoint(sppointnum);
+          for (int j = 0; j < ntrigs; j++)
+            {
+              PointGeomInfo gi;
+              gi.trignum = geom.TrigPerPoint(sppointnum, j+1);
+              mgi.AddPointGeomInfo (gi);
+            }
+
+          // Einfuegen von ConePoint: Point bekommt alle
+          // Dreiecke (werden dann intern kopiert)
+          // Ein Segment zum ConePoint muss vorhanden sein !!!
+
+          // meshing.AddPoint (mesh.Point(i), i, &mgi);
+          meshing.AddPoint (mesh[pi], pi, &mgi);
+        }
+      else
+        meshing.AddPoint (mesh[pi], pi);
+    }
+
+  NgProfiler::StopTimer (timer1c);
+  NgProfiler::StartTimer (timer1d);
+
+  /*
+    for (int i = 1; i <= mesh.GetNOpenSegments(); i++)
+      {
+        const Segment & seg = mesh.GetOpenSegment (i);
+        if (seg.si == fnr)
+          meshing.AddBoundaryElement (compress[seg[0]], compress[seg[1]],
+                                      seg.geominfo[0], seg.geominfo[1]);
+      }
+  */
+
+
+  // NgFlatArray<int> segs = opensegments[fnr];
+  for (int hi = 0; hi < segs.Size(); hi++)
+    {
+      int i = segs[hi];
+      const Segment & seg = mesh.GetOpenSegment (i);
+      meshing.AddBoundaryElement (compress[seg[0]], compress[seg[1]],
+                                  seg.geominfo[0], seg.geominfo[1]);
+    }
+
+
+
+  NgProfiler::StopTimer (timer1d);
+
+  NgProfiler::StopTimer (timer1);
+
+  PrintMessage(3,"start meshing, trialcnt = ", retrynr);
+
+  meshing.GenerateMesh (fmesh, mparam, h, fnr);
+
+  for (int i = 0; i < icompress.Size(); i++)
+    compress[icompress[i]] = 0;
+}
+
+
+void STLSurfaceMeshing1 (STLGeometry & geom,
+			 Mesh & mesh,
+                         const MeshingParameters& mparam,
+			 int retrynr,
+                         const STLParameters& stlparam)
+{
   mesh.FindOpenSegments();
-  
+
   NgArray<int> spiralps(0);
   spiralps.SetSize(0);
   for (int i = 1; i <= geom.GetNP(); i++)
-    if (geom.GetSpiralPoint(i)) 
+    if (geom.GetSpiralPoint(i))
       spiralps.Append(i);
-  
+
   PrintMessage(7,"NO spiralpoints = ", spiralps.Size());
   //int spfound;
 
@@ -637,7 +775,7 @@ void STLSurfaceMeshing1 (STLGeometry & geom,
   meshsp = 0;
   for (int i = 1; i <= mesh.GetNP(); i++)
     for (int j = 1; j <= spiralps.Size(); j++)
-      if (Dist2(geom.GetPoint(spiralps.Get(j)), mesh.Point(i)) < 1e-20) 
+      if (Dist2(geom.GetPoint(spiralps.Get(j)), mesh.Point(i)) < 1e-20)
 	meshsp.Elem(i) = spiralps.Get(j);
   NgArray<PointIndex> imeshsp;
   for (int i = 1; i <= meshsp.Size(); i++)
@@ -648,7 +786,7 @@ void STLSurfaceMeshing1 (STLGeometry & geom,
   for (int i = 1; i <= mesh.GetNP(); i++)
     {
       for (int j = 1; j <= spiralps.Size(); j++)
-	if (Dist2(geom.GetPoint(spiralps.Get(j)), mesh.Point(i)) < 1e-20) 
+	if (Dist2(geom.GetPoint(spiralps.Get(j)), mesh.Point(i)) < 1e-20)
 	  {
 	    imeshsp.Append(i);
 	    ispiral_point.Append(spiralps.Get(j));
@@ -663,13 +801,12 @@ void STLSurfaceMeshing1 (STLGeometry & geom,
 
   NgArray<int,PointIndex::BASE> compress(mesh.GetNP());
   compress = 0;
-  NgArray<PointIndex> icompress; 
 
   NgArray<int, 1> opensegsperface(mesh.GetNFD());
   opensegsperface = 0;
   for (int i = 1; i <= mesh.GetNOpenSegments(); i++)
     opensegsperface[mesh.GetOpenSegment(i).si]++;
-  
+
   TABLE<int, 1> opensegments(mesh.GetNFD());
   for (int i = 1; i <= mesh.GetNOpenSegments(); i++)
     {
@@ -678,146 +815,80 @@ void STLSurfaceMeshing1 (STLGeometry & geom,
 	cerr << "segment index " << seg.si << " out of range [1, " << mesh.GetNFD() << "]" << endl;
       opensegments.Add (seg.si, i);
     }
-  
-
-  for (int fnr = 1; fnr <= mesh.GetNFD(); fnr++)
-    {
-      if (!opensegsperface[fnr]) continue;
-      if (multithread.terminate) return;
-
-      NgProfiler::StartTimer (timer1);
-      NgProfiler::StartTimer (timer1a);
-
-
-      PrintMessage(5,"Meshing surface ", fnr, "/", mesh.GetNFD());
-      MeshingSTLSurface meshing (geom, mparam);
-      meshing.SetStartTime (starttime);
-      
-      // compress = 0;
-      icompress.SetSize(0); 
-      int cntused = 0;
-
-      for (int i = 0; i < imeshsp.Size(); i++)
-	{
-	  compress[imeshsp[i]] = ++cntused;
-	  icompress.Append(imeshsp[i]);
-	}
-
-      NgProfiler::StopTimer (timer1a);
-      NgProfiler::StartTimer (timer1b);
-
 
 
-      /*
-      for (int i = 1; i <= mesh.GetNOpenSegments(); i++)
-	{
-	  const Segment & seg = mesh.GetOpenSegment (i);
-	  if (seg.si == fnr)
-	    for (int j = 0; j < 2; j++)
-	      if (compress[seg[j]] == 0)
-		{
-		  compress[seg[j]] = ++cntused;
-		  icompress.Append(seg[j]);
-		}
-	}
-      */
-      NgFlatArray<int> segs = opensegments[fnr];
-      for (int hi = 0; hi < segs.Size(); hi++)
-	{
-	  int i = segs[hi];
-	  const Segment & seg = mesh.GetOpenSegment (i);
-	  for (int j = 0; j < 2; j++)
-	    if (compress[seg[j]] == 0)
-	      {
-		compress[seg[j]] = ++cntused;
-		icompress.Append(seg[j]);
-	      }
-	}
-
-      NgProfiler::StopTimer (timer1b);
-      NgProfiler::StartTimer (timer1c);
-
-
-      for (int hi = 0; hi < icompress.Size(); hi++)
-	{
-	  PointIndex pi = icompress[hi];
-	  
-	  /*
-	  // int sppointnum = meshsp.Get(i);
-	  int sppointnum = 0;
-	  if (hi < ispiral_point.Size())
-	    sppointnum = ispiral_point[hi];
-
-	  if (sppointnum)
-	    {
-	  */
-	  if (hi < ispiral_point.Size())
-	    {
-	      int sppointnum = ispiral_point[hi];
-
-	      MultiPointGeomInfo mgi;
-	      
-	      int ntrigs = geom.NOTrigsPerPoint(sppointnum);
-	      for (int j = 0; j < ntrigs; j++)
-		{
-		  PointGeomInfo gi;
-		  gi.trignum = geom.TrigPerPoint(sppointnum, j+1);
-		  mgi.AddPointGeomInfo (gi);
-		}
-	      
-	      // Einfuegen von ConePoint: Point bekommt alle
-	      // Dreiecke (werden dann intern kopiert)
-	      // Ein Segment zum ConePoint muss vorhanden sein !!!
-	      
-	      // meshing.AddPoint (mesh.Point(i), i, &mgi);
-	      meshing.AddPoint (mesh[pi], pi, &mgi);
-	    }
-	  else
-	    meshing.AddPoint (mesh[pi], pi);
-	}
-
-      NgProfiler::StopTimer (timer1c);
-      NgProfiler::StartTimer (timer1d);
-
-      /*
-        for (int i = 1; i <= mesh.GetNOpenSegments(); i++)
-	  {
-	    const Segment & seg = mesh.GetOpenSegment (i);
-	    if (seg.si == fnr)
-	      meshing.AddBoundaryElement (compress[seg[0]], compress[seg[1]], 
-					  seg.geominfo[0], seg.geominfo[1]);
-	  }
-      */
+  Array<int> face_nrs;
+  for (int fnr = 1; fnr <= mesh.GetNFD(); fnr++)
+    if (opensegsperface[fnr])
+      face_nrs.Append (fnr);
 
+  // faces are separated by edges, so they are meshed concurrently into
+  // copies of the mesh. They are merged in face order below, so the
+  // numbering is the same as for serial meshing
+  Array<unique_ptr<FaceMeshData>> face_data(mesh.GetNFD());
+  auto first_new_pi = mesh.Points().Range().Next();
 
-      // NgFlatArray<int> segs = opensegments[fnr];
-      for (int hi = 0; hi < segs.Size(); hi++)
-	{
-	  int i = segs[hi];
-	  const Segment & seg = mesh.GetOpenSegment (i);
-	  meshing.AddBoundaryElement (compress[seg[0]], compress[seg[1]], 
-				      seg.geominfo[0], seg.geominfo[1]);
-	}
-
+  if (mparam.parallel_meshing && mparam.parallel_surface_meshing &&
+      face_nrs.Size() > 1)
+    {
+      static Timer t("STL surface meshing - parallel faces"); RegionTimer reg(t);
+
+      geom.Area();  // computed on first call
+
+      // face meshing refines the local h, every face gets its own
+      // copy of the mesh-size tree (restricted to the face)
+      Array<Box<3>> face_boxes(mesh.GetNFD());
+      face_boxes = Box<3>(Box<3>::EMPTY_BOX);
+      for (STLTrigId t = 1; t <= geom.GetNT(); t++)
+        {
+          int fnr = geom.GetTriangle(t).GetFaceNum();
+          if (fnr >= 1 && fnr <= mesh.GetNFD())
+            for (STLPointId pi : geom.GetTriangle(t).PNums())
+              face_boxes[fnr-1].Add (geom.GetPoint(pi));
+        }
+
+      RegionTaskManager rtm(mparam.nthreads);
+      ngcore::ParallelFor (face_nrs.Range(), [&] (auto i)
+        {
+          int fnr = face_nrs[i];
+          if (multithread.terminate) return;
+
+          Mesh fmesh;
+          fmesh = mesh;
+          Box<3> bb = face_boxes[fnr-1];
+          bb.Increase (bb.Diam()/10);
+          if (auto & loch = mesh.GetLocalH(); loch)
+            fmesh.SetLocalH (loch->Copy(bb));
+
+          NgArray<int,PointIndex::BASE> fcompress(mesh.GetNP());
+          fcompress = 0;
+          STLMeshFace (geom, mesh, fmesh, mparam, fnr, opensegments[fnr],
+                       imeshsp, ispiral_point, fcompress, starttime, retrynr);
+
+          auto data = make_unique<FaceMeshData>();
+          for (auto pi : Range(first_new_pi, fmesh.Points().Range().Next()))
+            data->points.Append (fmesh[pi]);
+          for (auto sei : Range(mesh.GetNSE(), fmesh.GetNSE()))
+            data->elements.Append (fmesh.SurfaceElements()[sei]);
+          face_data[fnr-1] = std::move(data);
+        }, face_nrs.Size());
+    }
 
+  for (int fnr : face_nrs)
+    {
+      if (multithread.terminate) return;
 
-      NgProfiler::StopTimer (timer1d);
+      if (face_data[fnr-1])
+        MergeFaceMesh (mesh, *face_data[fnr-1], first_new_pi);
+      else
+        STLMeshFace (geom, mesh, mesh, mparam, fnr, opensegments[fnr],
+                     imeshsp, ispiral_point, compress, starttime, retrynr);
 
-      NgProfiler::StopTimer (timer1);
-      
-      PrintMessage(3,"start meshing, trialcnt = ", retrynr);
-      
-      meshing.GenerateMesh (mesh, mparam, h, fnr);  
-      
-      for (int i = 0; i < icompress.Size(); i++)
-	compress[icompress[i]] = 0;
-      
-      
       mparam.Render();
-    }     
-  
+    }
+
   // NgProfiler::Print(stdout);
-  
+
   mesh.CalcSurfacesOfNode();
 }
 
@@ -911,7 +982,7 @@ void MeshingSTLSurface :: DefineTransformation (const Point<3> & p1, const Point
 {
   transformationtrig = geominfo[0].trignum;
   
-  geom.DefineTangentialPlane(p1, p2, transformationtrig);
+  geom.DefineTangentialPlane(chartstate, p1, p2, transformationtrig);
 }
 
 void MeshingSTLSurface :: TransformToPlain (const Point<3> & locpoint, const MultiPointGeomInfo & gi,
@@ -931,7 +1002,7 @@ void MeshingSTLSurface :: TransformToPlain (const Point<3> & locpoint, const Mul
   //  int trig = gi.trignum;
   //   (*testout) << "locpoint = " << locpoint;
 
-  geom.ToPlane (locpoint, trigs, plainpoint, h, zone, 1);
+  geom.ToPlane (chartstate, locpoint, trigs, plainpoint, h, zone, 1);
 
   //  geom.ToPlane (locpoint, NULL, plainpoint, h, zone, 1);
   /*
@@ -972,7 +1043,7 @@ int MeshingSTLSurface :: ComputePointGeomInfo (const Point3d & p, PointGeomInfo
   // if non-unique: 0
 
   Point<3> hp = p;
-  gi.trignum = geom.Project (hp);
+  gi.trignum = geom.Project (chartstate, hp);
 
   if (!gi.trignum)
     {
@@ -988,7 +1059,7 @@ ChooseChartPointGeomInfo (const MultiPointGeomInfo & mpgi,
 			  PointGeomInfo & pgi)
 {
   for (int i = 1; i <= mpgi.GetNPGI(); i++)
-    if (geom.TrigIsInOC (mpgi.GetPGI(i).trignum, geom.meshchart))
+    if (geom.TrigIsInOC (mpgi.GetPGI(i).trignum, chartstate.meshchart))
       {
 	pgi = mpgi.GetPGI(i);
 	return 0;
@@ -1016,7 +1087,7 @@ IsLineVertexOnChart (const Point3d & p1, const Point3d & p2,
 		     int endpoint, const PointGeomInfo & gi)
 {
   int lineendtrig = gi.trignum;
-  return geom.TrigIsInOC (lineendtrig, geom.meshchart);
+  return geom.TrigIsInOC (lineendtrig, chartstate.meshchart);
 
   // Vec3d baselinenormal = geom.meshtrignv;
   //  Vec3d linenormal = geom.GetTriangleNormal (lineendtrig);
@@ -1031,7 +1102,7 @@ GetChartBoundary (NgArray<Point<2>> & points,
   points.SetSize (0);
   points3d.SetSize (0);
   lines.SetSize (0);
-  geom.GetMeshChartBoundary (points, points3d, lines, h);
+  geom.GetMeshChartBoundary (chartstate, points, points3d, lines, h);
 }
 
 
@@ -1044,7 +1115,7 @@ int MeshingSTLSurface :: TransformFromPlain (const Point<2> & plainpoint,
 {
   //return 0, wenn alles OK
   Point<3> hp3d;
-  int res = geom.FromPlane (plainpoint, hp3d, h);
+  int res = geom.FromPlane (chartstate, plainpoint, hp3d, h);
   locpoint = hp3d;
   ComputePointGeomInfo (locpoint, gi);
   return res;
@@ -1055,7 +1126,7 @@ int MeshingSTLSurface ::
 BelongsToActiveChart (const Point3d & p, 
 		      const PointGeomInfo & gi)
 {
-  return (geom.TrigIsInOC(gi.trignum, geom.meshchart) != 0);
+  return (geom.TrigIsInOC(gi.trignum, chartstate.meshchart) != 0);
 }
 
 
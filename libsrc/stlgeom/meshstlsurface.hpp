@@ -21,6 +21,8 @@ class MeshingSTLSurface : public Meshing2
   STLGeometry & geom;
   ///
   int transformationtrig;
+  /// selected chart and tangential plane
+  STLMeshChartState chartstate;
 public:
   ///
   MeshingSTLSurface (STLGeometry & ageom, const MeshingParameters & mp);
@@ -48,7 +48,7 @@ void STLMeshing (STLGeometry & geom,
   edgedata = make_unique<STLEdgeDataList>(*this);
   externaledges.SetSize(0);
   Clear();
-  meshchart = 0; // initialize all ?? JS
+  meshstate.meshchart = 0; // initialize all ?? JS
 
   if (geomsearchtreeon)
     searchtree = new BoxTree<3> (GetBoundingBox().PMin() - Vec3d(1,1,1),
@@ -121,17 +121,15 @@ bool STLGeometry :: CalcPointGeomInfo(int /*surfind*/, PointGeomInfo& gi, const
 
 bool STLGeometry :: ProjectPointGI (int surfind, Point<3> & p, PointGeomInfo & gi) const
 {
-  static std::mutex mutex_project_whole_surface;
   int meshchart = GetChartNr(gi.trignum);
   const STLChart& chart = GetChart(meshchart);
   int trignum = chart.ProjectNormal(p);
   if(trignum==0)
     {
-      // non-thread-safe implementation
-      std::lock_guard<std::mutex> guard(mutex_project_whole_surface);
       PrintMessage(7,"project failed");
-      SelectChartOfTriangle (gi.trignum); // needed because ProjectOnWholeSurface uses meshchartnv (the normal vector of selected chart)
-      trignum = ProjectOnWholeSurface(p);
+      // project along the normal of gi.trignum, without selecting its chart
+      int lasthit;
+      trignum = ProjectOnWholeSurface(p, GetTriangle(gi.trignum).Normal(), lasthit);
       if(trignum==0)
         {
 	  PrintMessage(7, "project on whole surface failed");
@@ -2194,10 +2192,6 @@ void STLGeometry :: InitSTLGeometry(const NgArray<STLReadTriangle> & readtrias)
       vicinity.Elem(i) = 1;
     }
 
-  ha_points.SetSize(GetNP());
-  for (i = 1; i <= GetNP(); i++)
-    ha_points.Elem(i) = 0;
-
   calcedgedataanglesnew = 0;
   edgedatastored = 0;
   edgedata->Clear();
@@ -2399,10 +2393,6 @@ int STLGeometry :: CheckGeometryOverlapping()
   vicinity.Elem(i) = 1;
   }
 
-  ha_points.SetSize(GetNP());
-  for (i = 1; i <= GetNP(); i++)
-  ha_points.Elem(i) = 0;
-
   calcedgedataanglesnew = 0;
   edgedatastored = 0;
   edgedata->Clear();
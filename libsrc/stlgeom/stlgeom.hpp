@@ -98,6 +98,15 @@ namespace netgen
 
 
 
+  // chart and tangential plane selected for meshing and projection.
+  // Every MeshingSTLSurface has its own, so faces can be meshed in parallel
+  struct STLMeshChartState
+  {
+    int meshchart = 0;
+    Vec<3> meshtrignv;
+    Vec<3> ex, ey, ez;
+    Point<3> p1;
+  };
 
 
 
@@ -148,9 +157,7 @@ namespace netgen
 
     //for meshing and project:
     NgArray<int> meshcharttrigs; //per trig: 1=belong to chart, 0 not
-    mutable int meshchart;
-
-    NgArray<int> ha_points;  // help array, np long, filled with 0 
+    mutable STLMeshChartState meshstate;
 
 
     // sharp geometric edges not declared as edges
@@ -158,11 +165,6 @@ namespace netgen
     INDEX_2_HASHTABLE<int> * smoothedges;
 
 
-    //transformation:
-    mutable Vec<3> meshtrignv;
-    Vec<3> ex, ey, ez;
-    Point<3> p1;
-
   public:
     int edgesfound;
     int surfacemeshed;
@@ -421,10 +423,15 @@ namespace netgen
     void GetInnerChartLimes(NgArray<twoint>& limes, ChartId chartnum);
 
     //FOR MESHING
-    int GetMeshChartNr () { return meshchart; }
+    int GetMeshChartNr () { return meshstate.meshchart; }
     void GetMeshChartBoundary (NgArray<Point<2>> & points,
 			       NgArray<Point<3>> & points3d,
-			       NgArray<INDEX_2> & lines, double h);
+			       NgArray<INDEX_2> & lines, double h)
+    { GetMeshChartBoundary (meshstate, points, points3d, lines, h); }
+    void GetMeshChartBoundary (const STLMeshChartState & state,
+                               NgArray<Point<2>> & points,
+			       NgArray<Point<3>> & points3d,
+			       NgArray<INDEX_2> & lines, double h) const;
 
 
     Point<3> PointBetween(const Point<3> & p1, int t1, const Point<3> & p2, int t2);
@@ -432,27 +439,43 @@ namespace netgen
     //select triangles in meshcharttrigs of actual (defined by trig) whole chart
     void PrepareSurfaceMeshing();
     //
-    void DefineTangentialPlane(const Point<3> & ap1, const Point<3> & ap2, int trig);
+    void DefineTangentialPlane(const Point<3> & ap1, const Point<3> & ap2, int trig)
+    { DefineTangentialPlane (meshstate, ap1, ap2, trig); }
+    void DefineTangentialPlane(STLMeshChartState & state, const Point<3> & ap1,
+                               const Point<3> & ap2, int trig) const;
     //
-    void SelectChartOfTriangle (int trignum) const;
+    void SelectChartOfTriangle (int trignum) const
+    { SelectChartOfTriangle (meshstate, trignum); }
+    void SelectChartOfTriangle (STLMeshChartState & state, int trignum) const;
     //
     void SelectChartOfPoint (const Point<3> & p);
     //
-    const Vec<3> & GetChartNormalVector () const { return meshtrignv; }
+    const Vec<3> & GetChartNormalVector () const { return meshstate.meshtrignv; }
 
     // list of trigs
     void ToPlane (const Point<3> & locpoint, int * trigs, Point<2> & plainpoint, 
-		  double h, int& zone, int checkchart);
+		  double h, int& zone, int checkchart)
+    { ToPlane (meshstate, locpoint, trigs, plainpoint, h, zone, checkchart); }
+    void ToPlane (const STLMeshChartState & state, const Point<3> & locpoint,
+                  int * trigs, Point<2> & plainpoint, 
+		  double h, int& zone, int checkchart) const;
     //return 0, wenn alles OK, 1 sonst
-    int FromPlane (const Point<2> & plainpoint, Point<3> & locpoint, double h);
+    int FromPlane (const Point<2> & plainpoint, Point<3> & locpoint, double h)
+    { return FromPlane (meshstate, plainpoint, locpoint, h); }
+    int FromPlane (const STLMeshChartState & state, const Point<2> & plainpoint,
+                   Point<3> & locpoint, double h) const;
   
     //get nearest point in actual chart and return any triangle where it lies on
     int ProjectNearest(Point<3> & p3d) const;
     //project point with normal nv from last define tangential plane
 
     int LastTrig() const;
-    int Project(Point<3> & p3d) const;
+    int Project(Point<3> & p3d) const { return Project (meshstate, p3d); }
+    int Project(const STLMeshChartState & state, Point<3> & p3d) const;
     int ProjectOnWholeSurface (Point<3> & p3d) const;
+    // project along nproj, does not use or set the selected chart (thread-safe)
+    // lasthit is set to the last hit triangle, also if the projection is ambiguous
+    int ProjectOnWholeSurface (Point<3> & p3d, const Vec<3> & nproj, int & lasthit) const;
 
     int GetNLines() const {return lines.Size();}
     int AddLine(STLLine* line) { lines.Append(line); return lines.Size(); }
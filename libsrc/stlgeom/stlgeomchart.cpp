@@ -322,6 +322,19 @@ void STLGeometry :: MakeAtlas(Mesh & mesh, const MeshingParameters& mparam, cons
       innerchartpts.SetSize(innerchartpoints.Size());
       for (size_t i = 0; i < innerchartpoints.Size(); i++)
         innerchartpts[i] = GetPoint(innerchartpoints[i]);
+
+      // search tree for the "close to inner chart" test of outer trigs,
+      // pays off for larger charts only
+      unique_ptr<BoxTree<3>> innertree;
+      if (innerchartpts.Size() > 100)
+        {
+          Box<3> innerbox(Box<3>::EMPTY_BOX);
+          for (auto & p : innerchartpts)
+            innerbox.Add (p);
+          innertree = make_unique<BoxTree<3>> (innerbox);
+          for (size_t i = 0; i < innerchartpts.Size(); i++)
+            innertree->Insert (innerchartpts[i], innerchartpts[i], i);
+        }
       
       // NgProfiler::StopTimer (timer2);
       // NgProfiler::StartTimer (timer3);
@@ -460,15 +473,28 @@ void STLGeometry :: MakeAtlas(Mesh & mesh, const MeshingParameters& mparam, cons
 				      }
 				  }
                                 */
-                                for (int l = 0; l < innerchartpts.Size(); l++)
-				  {
-				    double tdist = Dist2(pt, innerchartpts[l]);
-				    if (tdist < 4 * h2)
-				      {
-					accepted = true; 
-					break;
-				      }
-				  }
+                                if (innertree)
+                                  {
+                                    double hs = 2 * sqrt(h2);
+                                    innertree->GetFirstIntersecting
+                                      (pt-Vec<3>(hs,hs,hs), pt+Vec<3>(hs,hs,hs),
+                                       [&] (int l)
+                                       {
+                                         if (Dist2(pt, innerchartpts[l]) < 4 * h2)
+                                           accepted = true;
+                                         return accepted;
+                                       });
+                                  }
+                                else
+                                  for (int l = 0; l < innerchartpts.Size(); l++)
+                                    {
+                                      double tdist = Dist2(pt, innerchartpts[l]);
+                                      if (tdist < 4 * h2)
+                                        {
+                                          accepted = true; 
+                                          break;
+                                        }
+                                    }
 				if (accepted) break;
 			      }
                           
@@ -571,19 +597,23 @@ void STLGeometry :: MakeAtlas(Mesh & mesh, const MeshingParameters& mparam, cons
   PrintMessage(5, "NO outer chart trias=", cnttrias);
 
   //sort outerchartspertrig
+  ParallelFor (1, GetNT()+1, [&] (int first, int next)
+    {
+      for (int i = first; i < next; i++)
+        for (int k = 1; k < GetNOCPT(i); k++)
+          for (int j = 1; j < GetNOCPT(i); j++)
+            {
+              int swap = GetOCPT(i,j);
+              if (GetOCPT(i,j+1) < swap)
+                {
+                  SetOCPT(i,j,GetOCPT(i,j+1));
+                  SetOCPT(i,j+1,swap);
+                }
+            }
+    });
+
   for (int i = 1; i <= GetNT(); i++)
     {
-      for (int k = 1; k < GetNOCPT(i); k++)
-	for (int j = 1; j < GetNOCPT(i); j++)
-	  {
-	    int swap = GetOCPT(i,j);
-	    if (GetOCPT(i,j+1) < swap)
-	      {
-		SetOCPT(i,j,GetOCPT(i,j+1));
-		SetOCPT(i,j+1,swap);
-	      }
-	  }
-      
       // check make atlas
       if (GetChartNr(i) <= 0 || GetChartNr(i) > GetNOCharts()) 
 	PrintSysError("Make Atlas: chartnr(", i, ")=0!!");
@@ -598,8 +628,11 @@ void STLGeometry :: MakeAtlas(Mesh & mesh, const MeshingParameters& mparam, cons
   PrintMessage(5,"Make Atlas finished");
 
   
-  for (auto & chart : atlas)
-    chart->BuildInnerSearchTree();
+  ngcore::ParallelForRange (atlas.Range(), [&] (auto myrange)
+    {
+      for (ChartId i : myrange)
+        atlas[i]->BuildInnerSearchTree();
+    });
 
   PopStatus();
 }
@@ -295,20 +295,22 @@ Point<3> STLGeometry :: PointBetween(const Point<3> & ap1, int t1,
 
 void STLGeometry :: PrepareSurfaceMeshing()
 {
-  meshchart = -1; //clear no old chart
+  meshstate.meshchart = -1; //clear no old chart
   meshcharttrigs.SetSize(GetNT());
   meshcharttrigs = 0;
 }
 
-void STLGeometry::GetMeshChartBoundary (NgArray<Point<2>> & apoints,
+void STLGeometry::GetMeshChartBoundary (const STLMeshChartState & state,
+                                        NgArray<Point<2>> & apoints,
 					NgArray<Point<3>> & points3d,
-					NgArray<INDEX_2> & alines, double h)
+					NgArray<INDEX_2> & alines, double h) const
 {
   twoint seg, newseg;
   int zone;
   Point<2> p2;
 
-  const STLChart& chart = GetChart(meshchart);
+  const STLChart& chart = GetChart(state.meshchart);
+  INDEX_HASHTABLE<int> ha_points(2*chart.GetNOLimit()+1);
 
 
   for (int i = 1; i <= chart.GetNOLimit(); i++)
@@ -319,17 +321,17 @@ void STLGeometry::GetMeshChartBoundary (NgArray<Point<2>> & apoints,
 	{
 	  int pi = (j == 1) ? seg.i1 : seg.i2;
 	  int lpi;
-	  if (ha_points.Get(pi) == 0)
+	  if (!ha_points.Used(pi))
 	    {
 	      const Point<3> & p3d = GetPoint (pi);
 	      Point<2> p2d;
 
 	      points3d.Append (p3d);
-	      ToPlane(p3d, 0, p2d, h, zone, 0);
+	      ToPlane(state, p3d, 0, p2d, h, zone, 0);
 	      apoints.Append (p2d);
 	      
 	      lpi = apoints.Size();
-	      ha_points.Elem(pi) = lpi;
+	      ha_points.Set(pi, lpi);
 	    }
 	  else
 	    lpi = ha_points.Get(pi);
@@ -354,48 +356,42 @@ void STLGeometry::GetMeshChartBoundary (NgArray<Point<2>> & apoints,
       lines.Append (INDEX_2 (points.Size()-1, points.Size()));
       */
     }
-
-  for (int i = 1; i <= chart.GetNOLimit(); i++)
-    {
-      seg = chart.GetOLimit(i);
-      ha_points.Elem(seg.i1) = 0;
-      ha_points.Elem(seg.i2) = 0;
-    }
 }
 
-void STLGeometry :: DefineTangentialPlane (const Point<3> & ap1, const Point<3> & ap2, int trig)
+void STLGeometry :: DefineTangentialPlane (STLMeshChartState & state,
+                                            const Point<3> & ap1, const Point<3> & ap2, int trig) const
 {
-  p1 = ap1; //save for ToPlane, in data of STLGeometry class
+  state.p1 = ap1; //save for ToPlane, in the chart state
   Point<3> p2 = ap2; //only locally used
 
-  meshchart = GetChartNr(trig);
+  state.meshchart = GetChartNr(trig);
 
   if (usechartnormal)
-    meshtrignv = GetChart(meshchart).GetNormal();
+    state.meshtrignv = GetChart(state.meshchart).GetNormal();
   else
-    meshtrignv = GetTriangle(trig).Normal();
+    state.meshtrignv = GetTriangle(trig).Normal();
 
   //meshtrignv = GetTriangle(trig).Normal(points);
 
-  meshtrignv /= meshtrignv.Length();
+  state.meshtrignv /= state.meshtrignv.Length();
 
-  GetTriangle(trig).ProjectInPlain(points, meshtrignv, p2);
+  GetTriangle(trig).ProjectInPlain(points, state.meshtrignv, p2);
 
 
-  ez = meshtrignv;
-  ez /= ez.Length();
-  ex = p2 - p1;
-  ex -= (ex * ez) * ez;
-  ex /= ex.Length();
-  ey = Cross (ez, ex);
+  state.ez = state.meshtrignv;
+  state.ez /= state.ez.Length();
+  state.ex = p2 - state.p1;
+  state.ex -= (state.ex * state.ez) * state.ez;
+  state.ex /= state.ex.Length();
+  state.ey = Cross (state.ez, state.ex);
 
 }
 
 
-void STLGeometry :: SelectChartOfTriangle (int trignum) const
+void STLGeometry :: SelectChartOfTriangle (STLMeshChartState & state, int trignum) const
 {
-  meshchart = GetChartNr(trignum);
-  meshtrignv = GetTriangle(trignum).Normal();	
+  state.meshchart = GetChartNr(trignum);
+  state.meshtrignv = GetTriangle(trignum).Normal();	
 }
 
 
@@ -426,10 +422,12 @@ void STLGeometry :: SelectChartOfPoint (const Point<3> & p)
 
 
 
-void STLGeometry :: ToPlane (const Point<3> & locpoint, int * trigs,
+void STLGeometry :: ToPlane (const STLMeshChartState & state,
+                              const Point<3> & locpoint, int * trigs,
 			     Point<2> & plainpoint, double h, int& zone,
-			     int checkchart)
+			     int checkchart) const
 {
+  int meshchart = state.meshchart;
   if (checkchart)
     {
 
@@ -511,19 +509,20 @@ void STLGeometry :: ToPlane (const Point<3> & locpoint, int * trigs,
     }
   
   //transform in plane
-  Vec<3> p1p = locpoint - p1;
-  plainpoint(0) = (p1p * ex) / h;
-  plainpoint(1) = (p1p * ey) / h;
+  Vec<3> p1p = locpoint - state.p1;
+  plainpoint(0) = (p1p * state.ex) / h;
+  plainpoint(1) = (p1p * state.ey) / h;
 
 }
 
-int STLGeometry :: FromPlane (const Point<2> & plainpoint, 
-			      Point<3> & locpoint, double h)
+int STLGeometry :: FromPlane (const STLMeshChartState & state,
+                              const Point<2> & plainpoint, 
+			      Point<3> & locpoint, double h) const
 {
-  Vec<3> p1p = h * plainpoint[0] * ex + h * plainpoint[1] * ey;
-  locpoint = p1 + p1p;
+  Vec<3> p1p = h * plainpoint[0] * state.ex + h * plainpoint[1] * state.ey;
+  locpoint = state.p1 + p1p;
 
-  int rv = Project(locpoint);
+  int rv = Project(state, locpoint);
   if (!rv) {return 1;} //project nicht gegangen
   return 0;
 }
@@ -532,7 +531,7 @@ int lasttrig;
 int STLGeometry :: LastTrig() const {return lasttrig;};
 
 //project normal to tangential plane
-int STLGeometry :: Project(Point<3> & p3d) const
+int STLGeometry :: Project(const STLMeshChartState & state, Point<3> & p3d) const
 {
   Point<3> p, pf;
 
@@ -542,7 +541,7 @@ int STLGeometry :: Project(Point<3> & p3d) const
   int different = 0;
   // const double lamtol = 1e-6;
 
-  const STLChart& chart = GetChart(meshchart);
+  const STLChart& chart = GetChart(state.meshchart);
 
   STLTrigId trig = chart.ProjectNormal(p3d);
   return trig;
@@ -627,48 +626,64 @@ int STLGeometry :: Project(Point<3> & p3d) const
 //project normal to tangential plane
 int STLGeometry :: ProjectOnWholeSurface(Point<3> & p3d) const
 {
-  Point<3> p, pf;
+  int hit = 0;
+  int fi = ProjectOnWholeSurface (p3d, meshstate.meshtrignv, hit);
+  if (hit != 0) {lasttrig = hit;}
+  return fi;
+}
 
-  int i;
-  int fi = 0;
-  int cnt = 0;
-  int different = 0;
+int STLGeometry :: ProjectOnWholeSurface(Point<3> & p3d, const Vec<3> & nproj,
+                                         int & lasthit) const
+{
   const double lamtol = 1e-6;
 
-  for (i = 1; i <= GetNT(); i++)
+  // collect all hits, and evaluate them in increasing triangle order
+  ArrayMem<tuple<STLTrigId,Point<3>>, 10> hits;
+  auto test = [&] (STLTrigId i)
     {
-      p = p3d;
+      // a singular system gives lam = 0, i.e. a wrong hit in point 1
+      if (nproj * GetTriangle(i).GeomNormal(points) == 0) return;
+      Point<3> p = p3d;
       Vec<3> lam;
       int err =
-	GetTriangle(i).ProjectInPlain(points, meshtrignv, p, lam);      
+	GetTriangle(i).ProjectInPlain(points, nproj, p, lam);      
       int inside = (err == 0 && lam(0) > -lamtol && 
 		    lam(1) > -lamtol && (1-lam(0)-lam(1)) > -lamtol);
-
-      /*
-      p = p3d;
-      GetTriangle(i).ProjectInPlain(points, meshtrignv, p);
-      if (GetTriangle(i).PointInside(points, p)) 
-      */
       if (inside)
-	{
-	  if (cnt != 0) 
-	    {
-	      if (Dist2(p,pf)>=1E-16) 
-		{
-		  //		  (*testout) << "ERROR: found two points to project which are different" << endl;
-		  //		  (*testout) << "p=" << p << ", pf=" << pf << endl;
-		  different = 1;
-		}
-	    }
-	  pf = p; fi = i; cnt++;
-	}
+        hits.Append (make_tuple (i, p));
+    };
+
+  const auto & trigtree = GetTriangleTree();
+  if (!trigtree.Empty())
+    {
+      trigtree.ForEachOnLine (p3d, nproj, test);
+      QuickSort (hits, [] (const auto & a, const auto & b)
+                 { return get<0>(a) < get<0>(b); });
+    }
+  else
+    for (STLTrigId i = 1; i <= GetNT(); i++)
+      test (i);
+
+  Point<3> pf;
+  int fi = 0;
+  int different = 0;
+
+  for (auto [i, p] : hits)
+    {
+      if (fi != 0 && Dist2(p,pf)>=1E-16) 
+        {
+          //		  (*testout) << "ERROR: found two points to project which are different" << endl;
+          //		  (*testout) << "p=" << p << ", pf=" << pf << endl;
+          different = 1;
+        }
+      pf = p; fi = i;
     }
   /*
   if (cnt == 2) {(*testout) << "WARNING: found 2 triangles to project" << endl;}
   if (cnt == 3) {(*testout) << "WARNING: found 3 triangles to project" << endl;}
   if (cnt > 3) {(*testout) << "WARNING: found more than 3 triangles to project" << endl;}
   */
-  if (fi != 0) {lasttrig = fi;}
+  lasthit = fi;
   if (fi != 0 && !different) {p3d = pf; return fi;}
 
   //  (*testout) << "WARNING: Project failed" << endl;
@@ -679,25 +694,44 @@ int STLGeometry :: ProjectOnWholeSurface(Point<3> & p3d) const
 
 int STLGeometry :: ProjectNearest(Point<3> & p3d) const
 {
-  Point<3> p, pf = 0.0;
+  Point<3> pf = 0.0;
+  int meshchart = meshstate.meshchart;
 
   //set new chart
   const STLChart& chart = GetChart(meshchart);
-  int i;
-  double nearest = 1E50;
-  double dist;
   int ft = 0;
 
-  for (i = 1; i <= chart.GetNT(); i++)
+  const auto & trigtree = GetTriangleTree();
+  if (!trigtree.Empty())
     {
-      p = p3d;
-      dist  = GetTriangle(chart.GetTrig1(i)).GetNearestPoint(points, p);
-      if (dist < nearest)
-	{
-	  pf = p;
-	  nearest = dist;
-	  ft = chart.GetTrig1(i);
-	}      
+      // triangles of the chart, including its outer triangles
+      ft = trigtree.FindNearest (p3d, [&] (STLTrigId ti)
+        {
+          if (GetChartNr(ti) != meshchart && !TrigIsInOC (ti, meshchart))
+            return 1e99;
+          Point<3> p = p3d;
+          return GetTriangle(ti).GetNearestPoint(points, p);
+        });
+      if (ft)
+        {
+          pf = p3d;
+          GetTriangle(ft).GetNearestPoint(points, pf);
+        }
+    }
+  else
+    {
+      double nearest = 1E50;
+      for (int i = 1; i <= chart.GetNT(); i++)
+        {
+          Point<3> p = p3d;
+          double dist = GetTriangle(chart.GetTrig1(i)).GetNearestPoint(points, p);
+          if (dist < nearest)
+            {
+              pf = p;
+              nearest = dist;
+              ft = chart.GetTrig1(i);
+            }      
+        }
     }
   p3d = pf;
   //if (!ft) {(*testout) << "ERROR: ProjectNearest failed" << endl;}
@@ -707,102 +741,121 @@ int STLGeometry :: ProjectNearest(Point<3> & p3d) const
 
 
 
+
 	
+// surface curvature across the common edge of two neighbour triangles
+struct STLCurvatureRadius
+{
+  STLPointId p1, p2;   // common points
+  double rzyl;         // radius of the approximating cylinder
+  bool valid = false;  // false for geometry edges and degenerate pairs
+};
+
+// curvature radii of all neighbour pairs, 3 per triangle in the order of
+// the triangle loop. Computed in parallel, the caller restricts the local h
+static Array<STLCurvatureRadius> CalcCurvatureRadii (STLGeometry & geom)
+{
+  static Timer t("STL curvature radii"); RegionTimer reg(t);
+
+  double objectsize = geom.GetBoundingBox().Diam();
+  double geometryignoreedgelength = objectsize * 1e-5;
+
+  if (geom.GetEPPSize() == 0)
+    geom.BuildEdgesPerPoint();  // built on demand by IsEdge, not thread-safe
+
+  Array<STLCurvatureRadius> radii(3*geom.GetNT());
+  ngcore::ParallelForRange (geom.GetNT(), [&] (auto myrange)
+    {
+      for (auto ti : myrange)
+        {
+          STLTrigId i = int(ti)+1;
+          const STLTriangle& trig = geom.GetTriangle(i);
+          Vec<3> n = trig.Normal();
+          for (int j = 1; j <= 3; j++)
+            {
+              STLCurvatureRadius & rad = radii[3*ti+j-1];
+              const STLTriangle& nt = geom.GetTriangle(geom.NeighbourTrig(i,j));
+
+              STLPointId ap1, ap2, p3;
+              trig.GetNeighbourPointsAndOpposite(nt,ap1,ap2,p3);
+
+              //checken, ob ap1-ap2 eine Kante sind
+              if (geom.IsEdge(ap1,ap2)) continue;
+
+              STLPointId p4 = trig.PNum(1) + trig.PNum(2) + trig.PNum(3) - ap1 - ap2;
+
+              Point<3> p1p = geom.GetPoint(ap1), p2p = geom.GetPoint(ap2);
+              Point<3> p3p = geom.GetPoint(p3), p4p = geom.GetPoint(p4);
+
+              double h1 = GetDistFromInfiniteLine(p1p,p2p, p4p);
+              double h2 = GetDistFromInfiniteLine(p1p,p2p, p3p);
+              double diaglen = Dist (p1p, p2p);
+
+              if (diaglen < geometryignoreedgelength)
+                continue;
+              double rzyl = ComputeCylinderRadius (n, nt.Normal(), h1, h2);
+
+              if (h1 < 1e-3 * diaglen && h2 < 1e-3 * diaglen)
+                continue;
+              if (h1 < 1e-5 * objectsize && h2 < 1e-5 * objectsize)
+                continue;
+
+              rad.p1 = ap1;
+              rad.p2 = ap2;
+              rad.rzyl = rzyl;
+              rad.valid = true;
+            }
+        }
+    });
+  return radii;
+}
+
+
 //Restrict local h due to curvature for make atlas
 void STLGeometry :: RestrictLocalHCurv(class Mesh & mesh, double gh, const STLParameters& stlparam)
 {
+  static Timer t("STL RestrictLocalHCurv"); RegionTimer reg(t);
   PushStatusF("Restrict H due to surface curvature");
 
   //bei jedem Dreieck alle Nachbardreiecke vergleichen, und, fallskein Kante dazwischen,
   //die Meshsize auf ein bestimmtes Mass limitieren
-  int i,j;
-
-  STLPointId ap1,ap2,p3,p4;
-  Point<3> p1p, p2p, p3p, p4p;
-  Vec<3> n, ntn;
-  double rzyl, localh;
 
   //  double localhfact = 0.5;
   // double geometryignorelength = 1E-4;
   double minlocalh = stlparam.atlasminh;
 
-  Box<3> bb = GetBoundingBox();
   //  mesh.SetLocalH(bb.PMin() - Vec3d(10, 10, 10),bb.PMax() + Vec3d(10, 10, 10),
   //		 mparam.grading);
 
   //  mesh.SetGlobalH(gh);
 
   double mincalch = 1E10;
-  double maxcalch = -1E10
-;
-  double objectsize = bb.Diam();
-  double geometryignoreedgelength = objectsize * 1e-5;
-
+  double maxcalch = -1E10;
 
   if (stlparam.resthatlasenable)
     {
-      NgArray<double> minh; //minimales h pro punkt
-      minh.SetSize(GetNP());
-      for (i = 1; i <= GetNP(); i++)
-	{
-	  minh.Elem(i) = gh;
-	}
-      
-      for (i = 1; i <= GetNT(); i++)
+      auto radii = CalcCurvatureRadii (*this);
+
+      static Timer tr("STL RestrictLocalHCurv - restrict"); RegionTimer regr(tr);
+      for (int i = 0; i < radii.Size(); i++)
 	{
-	  SetThreadPercent((double)i/(double)GetNT()*100.);
+	  if (i % 3 == 0)
+	    SetThreadPercent((double)i/(double)radii.Size()*100.);
 
 	  if (multithread.terminate)
 	    {PopStatus(); return;}
 
-	  const STLTriangle& trig = GetTriangle(i);
-	  n = GetTriangle(i).Normal();
-	  for (j = 1; j <= 3; j++)
-	    {
-	      const STLTriangle& nt = GetTriangle(NeighbourTrig(i,j));
-	      
-	      trig.GetNeighbourPointsAndOpposite(nt,ap1,ap2,p3);	    	    
-	      
-	      //checken, ob ap1-ap2 eine Kante sind
-	      if (IsEdge(ap1,ap2)) continue;
-	      
-	      p4 = trig.PNum(1) + trig.PNum(2) + trig.PNum(3) - ap1 - ap2;
-	      
-	      p1p = GetPoint(ap1); p2p = GetPoint(ap2); 
-	      p3p = GetPoint(p3); p4p = GetPoint(p4);
-	      
-	      double h1 = GetDistFromInfiniteLine(p1p,p2p, p4p);
-	      double h2 = GetDistFromInfiniteLine(p1p,p2p, p3p);
-	      double diaglen = Dist (p1p, p2p);
-	      
-	      if (diaglen < geometryignoreedgelength)
-		continue;
-	      rzyl = ComputeCylinderRadius 
-		(n, GetTriangle(NeighbourTrig(i,j)).Normal(), 
-		 h1, h2);
-	      
-	      
-	      if (h1 < 1e-3 * diaglen && h2 < 1e-3 * diaglen)
-		continue;
-	      if (h1 < 1e-5 * objectsize && h2 < 1e-5 * objectsize)
-		continue;
-	      
-	      
-	      //	      rzyl = mindist/(2*sinang);
-	      localh = 10.*rzyl / stlparam.resthatlasfac;
-	      if (localh < mincalch) {mincalch = localh;}
-	      if (localh > maxcalch) {maxcalch = localh;}
+	  const STLCurvatureRadius & rad = radii[i];
+	  if (!rad.valid) continue;
 
-	      if (localh < minlocalh) {localh = minlocalh;}
-	      if (localh < gh)
-		{
-		  minh.Elem(ap1) = min2(minh.Elem(ap1),localh);
-		  minh.Elem(ap2) = min2(minh.Elem(ap2),localh);
-		}
-	      
-	      mesh.RestrictLocalHLine(p1p, p2p, localh);
-	    }
-	  
+	  //	      rzyl = mindist/(2*sinang);
+	  double localh = 10.*rad.rzyl / stlparam.resthatlasfac;
+	  if (localh < mincalch) {mincalch = localh;}
+	  if (localh > maxcalch) {maxcalch = localh;}
+
+	  if (localh < minlocalh) {localh = minlocalh;}
+
+	  mesh.RestrictLocalHLine(GetPoint(rad.p1), GetPoint(rad.p2), localh);
 	}
     }
   PrintMessage(5, "done\nATLAS H: nmin local h=", mincalch);
@@ -816,14 +869,12 @@ void STLGeometry :: RestrictLocalHCurv(class Mesh & mesh, double gh, const STLPa
   //restrict local h due to near edges and due to outer chart distance
 void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParameters& stlparam, const MeshingParameters& mparam)
 {
+  static Timer t("STL RestrictLocalH"); RegionTimer reg(t);
   
   //bei jedem Dreieck alle Nachbardreiecke vergleichen, und, fallskein Kante dazwischen,
   //die Meshsize auf ein bestimmtes Mass limitieren
   int i,j;
 
-  STLPointId ap1,ap2,p3,p4;
-  Point3d p1p, p2p, p3p, p4p;
-  Vec3d n, ntn;
   double rzyl, localh;
 
   //  double localhfact = 0.5;
@@ -839,83 +890,41 @@ void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParame
   double maxcalch = -1E10;
 
   double objectsize = bb.Diam();
-  double geometryignoreedgelength = objectsize * 1e-5;
 
   if (stlparam.resthsurfcurvenable)
     {
+      static Timer tc("STL RestrictLocalH - surface curvature"); RegionTimer regc(tc);
       PushStatusF("Restrict H due to surface curvature");
 
-      NgArray<double> minh; //minimales h pro punkt
-      minh.SetSize(GetNP());
-      for (i = 1; i <= GetNP(); i++)
-	{
-	  minh.Elem(i) = gh;
-	}
+      auto radii = CalcCurvatureRadii (*this);
 
-      for (i = 1; i <= GetNT(); i++)
+      for (i = 0; i < radii.Size(); i++)
 	{
-	  SetThreadPercent((double)i/(double)GetNT()*100.);
-	  if (i%20000==19999) {PrintMessage(7, (double)i/(double)GetNT()*100. , "%");}
+	  if (i % 3 == 0)
+	    {
+	      SetThreadPercent((double)i/(double)radii.Size()*100.);
+	      if (i/3%20000==19999) {PrintMessage(7, (double)i/(double)radii.Size()*100. , "%");}
+	    }
 
 	  if (multithread.terminate)
 	    {PopStatus(); return;}
-	  
-	  const STLTriangle& trig = GetTriangle(i);
-	  n = GetTriangle(i).Normal();
-	  for (j = 1; j <= 3; j++)
-	    {
-	      const STLTriangle& nt = GetTriangle(NeighbourTrig(i,j));
-	      
-	      trig.GetNeighbourPointsAndOpposite(nt,ap1,ap2,p3);	    	    
-	      
-	      //checken, ob ap1-ap2 eine Kante sind
-	      if (IsEdge(ap1,ap2)) continue;
-	      
-	      p4 = trig.PNum(1) + trig.PNum(2) + trig.PNum(3) - ap1 - ap2;
-	      
-	      p1p = GetPoint(ap1); p2p = GetPoint(ap2); 
-	      p3p = GetPoint(p3); p4p = GetPoint(p4);
-	      
-	      double h1 = GetDistFromInfiniteLine(p1p,p2p, p4p);
-	      double h2 = GetDistFromInfiniteLine(p1p,p2p, p3p);
-	      double diaglen = Dist (p1p, p2p);
-	      
-	      if (diaglen < geometryignoreedgelength)
-		continue;
-	      rzyl = ComputeCylinderRadius 
-		(n, GetTriangle (NeighbourTrig(i,j)).Normal(), 
-		 h1, h2);
-	      
-	      
-	      if (h1 < 1e-3 * diaglen && h2 < 1e-3 * diaglen)
-		continue;
-	      
-	      if (h1 < 1e-5 * objectsize && h2 < 1e-5 * objectsize)
-		continue;
-	      
-	      
-	      //	      rzyl = mindist/(2*sinang);
-	      localh = rzyl / stlparam.resthsurfcurvfac;
-	      if (localh < mincalch) {mincalch = localh;}
-	      if (localh > maxcalch) {maxcalch = localh;}
-	      if (localh < gh) 
-		{
-		  minh.Elem(ap1) = min2(minh.Elem(ap1),localh);
-		  minh.Elem(ap2) = min2(minh.Elem(ap2),localh);
-		}
-	      
-	      //if (localh < 0.2) {localh = 0.2;}
 
-	      if(localh < objectsize)
-		mesh.RestrictLocalHLine(p1p, p2p, localh);
-	      (*testout) << "restrict h along " << p1p << " - " << p2p << " to " << localh << endl;
-	      
-	      if (localh < 0.1)
-		{
-		  localh = 0.1;
-		}
-	      
-	    }
+	  const STLCurvatureRadius & rad = radii[i];
+	  if (!rad.valid) continue;
+
+	  const Point<3> & p1p = GetPoint(rad.p1);
+	  const Point<3> & p2p = GetPoint(rad.p2);
+
+	  //	      rzyl = mindist/(2*sinang);
+	  localh = rad.rzyl / stlparam.resthsurfcurvfac;
+	  if (localh < mincalch) {mincalch = localh;}
+	  if (localh > maxcalch) {maxcalch = localh;}
+
+	  //if (localh < 0.2) {localh = 0.2;}
+
+	  if(localh < objectsize)
+	    mesh.RestrictLocalHLine(p1p, p2p, localh);
+	  (*testout) << "restrict h along " << p1p << " - " << p2p << " to " << localh << endl;
 	}
       PrintMessage(7, "done\nmin local h=", mincalch, "\nmax local h=", maxcalch);
       PopStatus();
@@ -923,6 +932,7 @@ void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParame
 
   if (mparam.closeedgefac.has_value())
     {
+      static Timer tce("STL RestrictLocalH - close edges"); RegionTimer regce(tce);
       PushStatusF("Restrict H due to close edges");
       //geht nicht für spiralen!!!!!!!!!!!!!!!!!!
       
@@ -1020,13 +1030,44 @@ void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParame
 
   if (stlparam.resthedgeangleenable)
     {
+      static Timer te("STL RestrictLocalH - edge angle"); RegionTimer rege(te);
       PushStatusF("Restrict h due to close edges");
 
-      int lp1, lp2;
-      Vec3d v1,v2;
       mincalch = 1E50;
       maxcalch = -1E50;
 
+      // h from the angle between the two edges at a point, 0 if none
+      if (GetEPPSize() == 0) BuildEdgesPerPoint();
+      Array<double> edgeangleh(GetNP());
+      ngcore::ParallelForRange (GetNP(), [&] (auto myrange)
+        {
+          for (auto pi : myrange)
+            {
+              int i = int(pi)+1;
+              edgeangleh[pi] = 0;
+              if (GetNEPP(i) != 2 || IsLineEndPoint(i)) continue;
+
+              int lp1, lp2;
+              if (GetEdge(GetEdgePP(i,1)).PNum(2) == GetEdge(GetEdgePP(i,2)).PNum(1) ||
+                  GetEdge(GetEdgePP(i,1)).PNum(1) == GetEdge(GetEdgePP(i,2)).PNum(2))
+                {
+                  lp1 = 1; lp2 = 2;
+                }
+              else
+                {
+                  lp1 = 2; lp2 = 1;
+                }
+
+              Vec3d v1 = Vec3d(GetPoint(GetEdge(GetEdgePP(i,1)).PNum(1)),
+                               GetPoint(GetEdge(GetEdgePP(i,1)).PNum(2)));
+              Vec3d v2 = Vec3d(GetPoint(GetEdge(GetEdgePP(i,2)).PNum(lp1)),
+                               GetPoint(GetEdge(GetEdgePP(i,2)).PNum(lp2)));
+
+              double rzyl = ComputeCylinderRadius(v1, v2, v1.Length(), v2.Length());
+              edgeangleh[pi] = rzyl / stlparam.resthedgeanglefac;
+            }
+        });
+
       for (i = 1; i <= GetNP(); i++)
 	{
 	  SetThreadPercent((double)i/(double)GetNP()*100.);
@@ -1035,24 +1076,7 @@ void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParame
 
 	  if (GetNEPP(i) == 2 && !IsLineEndPoint(i))
 	    {
-	      if (GetEdge(GetEdgePP(i,1)).PNum(2) == GetEdge(GetEdgePP(i,2)).PNum(1) ||
-		  GetEdge(GetEdgePP(i,1)).PNum(1) == GetEdge(GetEdgePP(i,2)).PNum(2))
-		{
-		  lp1 = 1; lp2 = 2;
-		}
-	      else
-		{
-		  lp1 = 2; lp2 = 1;
-		}
-
-	      v1 = Vec3d(GetPoint(GetEdge(GetEdgePP(i,1)).PNum(1)),
-			 GetPoint(GetEdge(GetEdgePP(i,1)).PNum(2)));
-	      v2 = Vec3d(GetPoint(GetEdge(GetEdgePP(i,2)).PNum(lp1)),
-			 GetPoint(GetEdge(GetEdgePP(i,2)).PNum(lp2)));
-
-	      rzyl = ComputeCylinderRadius(v1, v2, v1.Length(), v2.Length());
-	      	      
-	      localh = rzyl / stlparam.resthedgeanglefac;
+	      localh = edgeangleh[i-1];
 	      if (localh < mincalch) {mincalch = localh;}
 	      if (localh > maxcalch) {maxcalch = localh;}
 	      
@@ -1066,6 +1090,7 @@ void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParame
 
   if (stlparam.resthchartdistenable)
     {
+      static Timer tcd("STL RestrictLocalH - chart distance"); RegionTimer regcd(tcd);
       PushStatusF("Restrict H due to outer chart distance");
       
       // mesh.LocalHFunction().Delete();
@@ -1091,6 +1116,7 @@ void STLGeometry :: RestrictLocalH(class Mesh & mesh, double gh, const STLParame
   if (stlparam.resthlinelengthenable)
     {
       //restrict h due to short lines
+      static Timer tl("STL RestrictLocalH - line length"); RegionTimer regl(tl);
       PushStatusF("Restrict H due to line-length");
       
       double minhl = 1E50;
@@ -1136,8 +1162,8 @@ void STLGeometry :: RestrictHChartDistOneChart(ChartId chartnum, NgArray<int>& a
 
   //  mincalch = 1E10;
   //maxcalch = -1E10;  
-  NgArray<int> limes1;
-  NgArray<int> limes2;
+  IndexSet limes1set(GetNP());
+  IndexSet limes2set(GetNP());
 	  
   NgArray<Point3d> plimes1;
   NgArray<Point3d> plimes2;
@@ -1153,8 +1179,6 @@ void STLGeometry :: RestrictHChartDistOneChart(ChartId chartnum, NgArray<int>& a
   // Point3d p3p1, p3p2;
   STLTriangle tt;
       
-  limes1.SetSize(0);
-  limes2.SetSize(0);
   plimes1.SetSize(0);
   plimes2.SetSize(0);
   plimes1trigs.SetSize(0);
@@ -1180,17 +1204,17 @@ void STLGeometry :: RestrictHChartDistOneChart(ChartId chartnum, NgArray<int>& a
 		  Point3d p3p1 = GetPoint(np1);
 		  Point3d p3p2 = GetPoint(np2);
 		  // if (AddIfNotExists(limes1,np1))
-                  if (!limes1.Contains(np1))
+                  if (!limes1set.IsIn(np1))
 		    {
-                      limes1.Append(np1);
+                      limes1set.Add(np1);
 		      plimes1.Append(p3p1); 
 		      plimes1trigs.Append(t);
 		      plimes1origin.Append(np1); 			      
 		    }
 		  // if (AddIfNotExists(limes1,np2))
-                  if (!limes1.Contains(np2))                  
+                  if (!limes1set.IsIn(np2))                  
 		    {
-                      limes1.Append(np2);                      
+                      limes1set.Add(np2);                      
 		      plimes1.Append(p3p2); 
 		      plimes1trigs.Append(t);
 		      plimes1origin.Append(np2); 			      
@@ -1237,15 +1261,15 @@ void STLGeometry :: RestrictHChartDistOneChart(ChartId chartnum, NgArray<int>& a
 			  
 		  // if (AddIfNotExists(limes2,np1)) {plimes2.Append(p3p1); plimes2trigs.Append(t);}
 		  // if (AddIfNotExists(limes2,np2)) {plimes2.Append(p3p2); plimes2trigs.Append(t);}
-		  if (!limes2.Contains(np1))
+		  if (!limes2set.IsIn(np1))
                     {
-                      limes2.Append(np1);
+                      limes2set.Add(np1);
                       plimes2.Append(p3p1);
                       plimes2trigs.Append(t);
                     }
-		  if (!limes2.Contains(np2))
+		  if (!limes2set.IsIn(np2))
                     {
-                      limes2.Append(np2);
+                      limes2set.Add(np2);
                       plimes2.Append(p3p2);
                       plimes2trigs.Append(t);
                     }
@@ -1281,58 +1305,42 @@ void STLGeometry :: RestrictHChartDistOneChart(ChartId chartnum, NgArray<int>& a
       Point3dTree stree(bbox.PMin(), bbox.PMax());
       for (int j = 1; j <= plimes2.Size(); j++)
 	stree.Insert (plimes2.Get(j), j);
-      NgArray<int> foundpts;
 	  
       NgProfiler::StopTimer (timer3a);
       NgProfiler::StartTimer (timer3b);
 
+      // the distances are computed in parallel with the mesh-size before
+      // restricting for this chart. A point found only due to the larger
+      // box has distance > GetH * limessafety, thus its restriction would
+      // not modify the mesh-size. The result is the same as of the
+      // sequential search with updated boxes.
+      NgArray<double> mindists(plimes1.Size());
+      ngcore::ParallelForRange (size_t(plimes1.Size()), [&] (auto myrange)
+        {
+          NgArray<int> foundpts;
+          for (auto j : myrange)
+            {
+              double mindist = 1E50;
+              const Point3d & ap1 = plimes1[j];
+              double boxs = mesh.GetH (ap1) * limessafety;
+
+              Point3d pmin = ap1 - Vec3d (boxs, boxs, boxs);
+              Point3d pmax = ap1 + Vec3d (boxs, boxs, boxs);
+
+              stree.GetIntersecting (pmin, pmax, foundpts);
+
+              for (int k : foundpts)
+                {
+                  double dist = Dist2(ap1, plimes2.Get(k));
+                  if (dist < mindist) mindist = dist;
+                }
+              mindists[j] = mindist;
+            }
+        });
+
       for (int j = 1; j <= plimes1.Size(); j++) 
 	{
-	  double mindist = 1E50;
-
-	  const Point3d & ap1 = plimes1.Get(j);
-	  double boxs = mesh.GetH (plimes1.Get(j)) * limessafety;
-
-	  Point3d pmin = ap1 - Vec3d (boxs, boxs, boxs);
-	  Point3d pmax = ap1 + Vec3d (boxs, boxs, boxs);
-
-	  stree.GetIntersecting (pmin, pmax, foundpts);
-
-
-	  for (int kk = 1; kk <= foundpts.Size(); kk++)
-	    {
-	      int k = foundpts.Get(kk);
-	      double dist = Dist2(plimes1.Get(j),plimes2.Get(k));
-	      if (dist < mindist) mindist = dist;
-	    }
-
-	  /*
-	    const Point3d & ap1 = plimes1.Get(j);
-	    double his = mesh.GetH (plimes1.Get(j));
-
-	    double xmin = ap1.X() - his * limessafety;
-	    double xmax = ap1.X() + his * limessafety;	      
-	    double ymin = ap1.Y() - his * limessafety;
-	    double ymax = ap1.Y() + his * limessafety;	      
-	    double zmin = ap1.Z() - his * limessafety;
-	    double zmax = ap1.Z() + his * limessafety;	      
-
-	    for (k = 1; k <= plimes2.Size(); k++)
-	    {
-	    const Point3d & ap2 = plimes2.Get(k);
-	    if (ap2.X() >= xmin && ap2.X() <= xmax &&
-	    ap2.Y() >= ymin && ap2.Y() <= ymax &&
-	    ap2.Z() >= zmin && ap2.Z() <= zmax)
-	    {
-	    dist = Dist2(plimes1.Get(j),plimes2.Get(k));
-	    if (dist < mindist) 
-	    {
-	    mindist = dist;
-	    }
-	    }
-	    }
-	  */
-	  mindist = sqrt(mindist);
+	  double mindist = sqrt(mindists.Get(j));
 	  localh = mindist/limessafety;
 
 	  if (localh < minh && localh != 0) {localh = minh;} //minh is generally 0! (except make atlas)
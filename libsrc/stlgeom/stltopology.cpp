@@ -17,7 +17,7 @@ namespace netgen
 
   STLTopology :: STLTopology()
   : trias(), topedges(), points(), ht_topedges(NULL), 
-    trigsperpoint(), neighbourtrigs()
+    trigsperpoint(), neighbourtrigs(), pointtree(NULL)
 {
   ;
 }
@@ -29,6 +29,207 @@ STLTopology :: ~STLTopology()
 
 
 
+namespace
+{
+  // reads the rest of the stream into one buffer
+  string ReadRemaining (istream & ist)
+  {
+    string data;
+    constexpr size_t blocksize = 1 << 20;
+    while (ist)
+      {
+        size_t oldsize = data.size();
+        data.resize (oldsize + blocksize);
+        ist.read (&data[oldsize], blocksize);
+        data.resize (oldsize + ist.gcount());
+      }
+    return data;
+  }
+
+  inline bool IsSpace (char c) { return isspace (static_cast<unsigned char>(c)); }
+
+  // whitespace separated tokens, as read by operator>>
+  class STLTokenizer
+  {
+    const char * p;
+    const char * end;
+  public:
+    STLTokenizer (const char * ap, const char * aend) : p(ap), end(aend) { }
+
+    string_view Next ()
+    {
+      while (p < end && IsSpace(*p)) p++;
+      const char * start = p;
+      while (p < end && !IsSpace(*p)) p++;
+      return string_view (start, p-start);
+    }
+
+    // false if the token is no plain number, where operator>> might differ
+    bool Get (double & val)
+    {
+      string_view tok = Next();
+      if (tok.size() > 1 && tok[0] == '+' && tok[1] != '-') tok.remove_prefix(1);
+      size_t first = (tok.size() && tok[0] == '-') ? 1 : 0;
+      if (first >= tok.size() ||
+          !(isdigit(static_cast<unsigned char>(tok[first])) || tok[first] == '.'))
+        return false;
+#ifdef __cpp_lib_to_chars
+      auto [next, ec] = std::from_chars (tok.data(), tok.data()+tok.size(), val);
+      return ec == std::errc() && next == tok.data()+tok.size();
+#else
+      string hs(tok);
+      char * next;
+      val = strtod (hs.c_str(), &next);
+      return next == hs.c_str()+hs.size();
+#endif
+    }
+  };
+
+  inline bool IsKeyword (string_view tok, const char * key)
+  {
+    size_t n = strlen(key);
+    if (tok.size() != n) return false;
+    for (size_t i = 0; i < n; i++)
+      if (tolower(static_cast<unsigned char>(tok[i])) != key[i]) return false;
+    return true;
+  }
+
+  // result of parsing a part of an ASCII STL file
+  struct STLAsciiChunk
+  {
+    Array<STLReadTriangle> trigs;
+    Array<Vec<3>> flat;        // edge lengths of skipped flat triangles
+    bool ok = true;            // numbers parsed, normal known before first triangle
+    int vertex = 0;            // vertex counter at the end of the chunk
+    bool badnormals = false;
+  };
+
+  // same state machine as the sequential loop in STLTopology::Load,
+  // starting with vertex counter 0 and no normal vector
+  void ParseSTLAscii (const char * begin, const char * end, STLAsciiChunk & chunk)
+  {
+    STLTokenizer tokens(begin, end);
+    Point<3> pts[3];
+    Vec<3> normal;
+    bool hasnormal = false;
+    int & vertex = chunk.vertex;
+
+    while (true)
+      {
+        string_view tok = tokens.Next();
+        if (tok.empty()) break;
+
+        if (IsKeyword (tok, "normal"))
+          {
+            if (!tokens.Get(normal(0)) || !tokens.Get(normal(1)) || !tokens.Get(normal(2)))
+              { chunk.ok = false; return; }
+            normal.Normalize();
+            hasnormal = true;
+          }
+
+        if (IsKeyword (tok, "vertex"))
+          {
+            if (!tokens.Get(pts[vertex](0)) || !tokens.Get(pts[vertex](1)) ||
+                !tokens.Get(pts[vertex](2)))
+              { chunk.ok = false; return; }
+            vertex++;
+
+            if (vertex == 3)
+              {
+                if (!hasnormal) { chunk.ok = false; return; }
+
+                if (normal.Length() <= 1e-5)
+                  {
+                    normal = Cross (pts[1]-pts[0], pts[2]-pts[0]);
+                    normal.Normalize();
+                  }
+                else
+                  {
+                    Vec<3> hnormal = Cross (pts[1]-pts[0], pts[2]-pts[0]);
+                    hnormal.Normalize();
+                    if (normal * hnormal < 0.5)
+                      chunk.badnormals = true;
+                  }
+
+                vertex = 0;
+
+                if ( (Dist2 (pts[0], pts[1]) > 1e-16) &&
+                     (Dist2 (pts[0], pts[2]) > 1e-16) &&
+                     (Dist2 (pts[1], pts[2]) > 1e-16) )
+                  chunk.trigs.Append (STLReadTriangle (pts, normal));
+                else
+                  chunk.flat.Append (Vec<3> (Dist(pts[0], pts[1]), Dist(pts[0], pts[2]),
+                                             Dist(pts[2], pts[1])));
+              }
+          }
+      }
+  }
+
+  // splits the buffer in front of 'facet' tokens and parses the parts in parallel,
+  // returns false if the result may differ from the sequential parser
+  bool ParseSTLAsciiParallel (const string & data, size_t start,
+                              NgArray<STLReadTriangle> & readtrigs, bool & badnormals)
+  {
+    static Timer t("STL ASCII parser"); RegionTimer reg(t);
+
+    const char * buf = data.data();
+    size_t size = data.size();
+    size_t nchunks = min2 (size_t(ngcore::TaskManager::GetNumThreads() * 4),
+                           size_t(1 + (size-start) / (1 << 16)));
+
+    Array<size_t> splits;
+    splits.Append (start);
+    for (size_t k = 1; k < nchunks; k++)
+      {
+        size_t pos = max2 (splits.Last(), start + k * (size-start) / nchunks);
+        while (pos + 6 < size &&
+               !(IsSpace(buf[pos]) && IsKeyword(string_view(buf+pos+1, 5), "facet") &&
+                 IsSpace(buf[pos+6])))
+          pos++;
+        if (pos + 6 >= size) break;
+        if (pos > splits.Last())
+          splits.Append (pos);
+      }
+    splits.Append (size);
+
+    Array<STLAsciiChunk> chunks(splits.Size()-1);
+    ngcore::ParallelFor (chunks.Size(), [&] (size_t k)
+                 {
+                   ParseSTLAscii (buf+splits[k], buf+splits[k+1], chunks[k]);
+                 });
+
+    for (size_t k = 0; k < chunks.Size(); k++)
+      if (!chunks[k].ok || (k+1 < chunks.Size() && chunks[k].vertex != 0))
+        return false;
+
+    size_t ntrigs = 0;
+    for (auto & chunk : chunks)
+      {
+        ntrigs += chunk.trigs.Size();
+        badnormals |= chunk.badnormals;
+        for (auto & l : chunk.flat)
+          cout << "Skipping flat triangle " 
+               << "l1 = " << l(0) << ", l2 = " << l(1) << ", l3 = " << l(2) << endl;
+      }
+
+    readtrigs.SetSize (ntrigs);
+    Array<size_t> first(chunks.Size());
+    for (size_t k = 0, sum = 0; k < chunks.Size(); k++)
+      {
+        first[k] = sum;
+        sum += chunks[k].trigs.Size();
+      }
+    ngcore::ParallelFor (chunks.Size(), [&] (size_t k)
+                 {
+                   for (size_t i = 0; i < chunks[k].trigs.Size(); i++)
+                     readtrigs[first[k]+i] = chunks[k].trigs[i];
+                 });
+    return true;
+  }
+}
+
+
+
 
 STLGeometry *  STLTopology :: LoadBinary (istream & ist)
 {
@@ -56,33 +257,32 @@ STLGeometry *  STLTopology :: LoadBinary (istream & ist)
   FIOReadInt(ist,nofacets);
   PrintMessage(5,"NO facets = ",nofacets);
 
-  Point<3> pts[3];
-  Vec<3> normal;
-
-  char spaces[nospaces+1];
-
-  for (int cntface = 0; cntface < nofacets; cntface++)
-    {
-      if (cntface % 10000 == 0)
-	// { PrintDot(); } 
-	PrintMessageCR (3, cntface, " triangles loaded\r");
-
-      float f;
-      FIOReadFloat(ist,f); normal(0) = f;
-      FIOReadFloat(ist,f); normal(1) = f;
-      FIOReadFloat(ist,f); normal(2) = f;
-      
-      for (int j = 0; j < 3; j++)
-	{
-	  FIOReadFloat(ist,f); pts[j](0) = f;
-	  FIOReadFloat(ist,f); pts[j](1) = f;
-	  FIOReadFloat(ist,f); pts[j](2) = f;	  
-	} 
-
-      readtrigs.Append (STLReadTriangle (pts, normal));
-      FIOReadString(ist,spaces,nospaces);
-    }	    
-  PrintMessage (3, nofacets, " triangles loaded\r");  
+  // read all facets at once, and convert them in parallel
+  {
+    static Timer t("STL binary reader"); RegionTimer reg(t);
+    constexpr size_t facetsize = 12*sizeof(float) + nospaces;
+    string data (size_t(max2(nofacets, 0)) * facetsize, '\0');
+    ist.read (&data[0], data.size());
+    size_t nread = ist.gcount() / facetsize;
+    if (nread < size_t(max2(nofacets, 0)))
+      PrintWarning("STL binary file contains only ", nread, " of ", nofacets, " triangles");
+
+    readtrigs.SetSize (nread);
+    ngcore::ParallelForRange (nread, [&] (auto myrange)
+      {
+        for (size_t i : myrange)
+          {
+            float f[12];
+            memcpy (f, &data[i*facetsize], sizeof(f));
+            Vec<3> normal (f[0], f[1], f[2]);
+            Point<3> pts[3];
+            for (int j = 0; j < 3; j++)
+              pts[j] = Point<3> (f[3+3*j], f[4+3*j], f[5+3*j]);
+            readtrigs[i] = STLReadTriangle (pts, normal);
+          }
+      });
+    PrintMessage (3, nread, " triangles loaded\r");
+  }
 
   geom->InitSTLGeometry(readtrigs);
 
@@ -369,6 +569,37 @@ STLGeometry *  STLTopology ::Load (istream & ist, bool surface)
   STLGeometry * geom = new STLGeometry();
 
   NgArray<STLReadTriangle> readtrigs;
+  bool badnormals = false;
+
+  string data = ReadRemaining (ist);
+  size_t start = 0;  // skip first token
+  while (start < data.size() && IsSpace(data[start])) start++;
+  while (start < data.size() && !IsSpace(data[start])) start++;
+
+  if (ParseSTLAsciiParallel (data, start, readtrigs, badnormals))
+    PrintMessage (3, readtrigs.Size(), " triangles loaded");
+  else
+    LoadAsciiSequential (data, readtrigs, badnormals);
+
+  if (badnormals) 
+    {
+      PrintWarning("File has normal vectors which differ extremely from geometry->correct with stldoctor!!!");
+    }
+
+  geom->surface = surface;
+  geom->InitSTLGeometry(readtrigs);
+  return geom;
+}
+
+
+void STLTopology :: LoadAsciiSequential (const string & data,
+                                         NgArray<STLReadTriangle> & readtrigs,
+                                         bool & badnormals)
+{
+  static Timer t("STL ASCII parser - sequential"); RegionTimer reg(t);
+  istringstream ist(data);
+  readtrigs.SetSize(0);
+  badnormals = false;
 
   char buf[100];
   Point<3> pts[3];
@@ -376,7 +607,6 @@ STLGeometry *  STLTopology ::Load (istream & ist, bool surface)
 
   [[maybe_unused]] int cntface = 0;
   int vertex = 0;
-  bool badnormals = false;
   ist >> buf; // skip first line
   
   while (ist.good())
@@ -451,16 +681,12 @@ STLGeometry *  STLTopology ::Load (istream & ist, bool surface)
 	}
     }
   PrintMessage (3, readtrigs.Size(), " triangles loaded");
+}
+
+
+
 
-  if (badnormals) 
-    {
-      PrintWarning("File has normal vectors which differ extremely from geometry->correct with stldoctor!!!");
-    }
 
-  geom->surface = surface;
-  geom->InitSTLGeometry(readtrigs);
-  return geom;
-}
 
 
 
@@ -469,13 +695,105 @@ STLGeometry *  STLTopology ::Load (istream & ist, bool surface)
 
 
 
+namespace
+{
+  /*
+    first[k] is the smallest index of a read vertex (k = 3*trig+j) with
+    exactly the same coordinates. Uses a spatial hash with cell size of
+    the order of tol. Returns false if different points are closer than
+    (about) tol, then the identification depends on the insertion order
+    into the point tree.
+  */
+  bool IdentifyEqualPoints (const NgArray<STLReadTriangle> & readtrigs,
+                            const Box<3> & bbox, double tol, Array<int> & first)
+  {
+    static Timer t("STL identify points"); RegionTimer reg(t);
 
+    size_t nv = 3 * readtrigs.Size();
+    if (nv == 0) return false;
+    auto point = [&] (size_t k) -> const Point<3> & { return readtrigs[k/3][k%3]; };
 
+    double h = 4*tol;
+    if (h <= 0) h = 1e-8 * bbox.Diam();
+    if (h <= 0) h = 1;
+    if (bbox.Diam() / h > 1e15) return false;
 
+    auto cell = [&] (double x, int dir) { return int64_t(floor ((x-bbox.PMin()(dir)) / h)); };
+    auto bucket = [&] (int64_t ix, int64_t iy, int64_t iz)
+      {
+        uint64_t key = uint64_t(ix)*73856093ull ^ uint64_t(iy)*19349663ull ^ uint64_t(iz)*83492791ull;
+        return int(key % nv);
+      };
+
+    atomic<bool> close(false);
+    auto buckets = ngcore::CreateSortedTable<int, int>
+      (IntRange(nv), [&] (auto & creator, size_t k)
+       {
+         const Point<3> & p = point(k);
+         if (!isfinite(p(0)) || !isfinite(p(1)) || !isfinite(p(2)))
+           { close = true; return; }
+         creator.Add (bucket (cell(p(0),0), cell(p(1),1), cell(p(2),2)), k);
+       }, nv);
+    if (close) return false;
+
+    // equal points are in the same bucket, sorted by index
+    first.SetSize (nv);
+    ngcore::ParallelForRange (buckets.Range(), [&] (auto myrange)
+      {
+        for (auto b : myrange)
+          {
+            FlatArray<int> row = buckets[b];
+            for (size_t i = 0; i < row.Size(); i++)
+              {
+                const Point<3> & p = point(row[i]);
+                first[row[i]] = row[i];
+                for (size_t j = 0; j < i; j++)
+                  {
+                    const Point<3> & q = point(row[j]);
+                    if (q(0) == p(0) && q(1) == p(1) && q(2) == p(2))
+                      {
+                        first[row[i]] = first[row[j]];
+                        break;
+                      }
+                  }
+              }
+          }
+      });
+
+    // look for different points in the neighbourhood of every distinct point
+    ngcore::ParallelForRange (nv, [&] (auto myrange)
+      {
+        for (size_t k : myrange)
+          {
+            if (first[k] != int(k) || close) continue;
+            const Point<3> & p = point(k);
+            int64_t lo[3], hi[3];
+            for (int d = 0; d < 3; d++)
+              {
+                lo[d] = cell (p(d)-2*tol, d);
+                hi[d] = cell (p(d)+2*tol, d);
+              }
+            for (int64_t ix = lo[0]; ix <= hi[0]; ix++)
+              for (int64_t iy = lo[1]; iy <= hi[1]; iy++)
+                for (int64_t iz = lo[2]; iz <= hi[2]; iz++)
+                  for (int j : buckets[bucket(ix,iy,iz)])
+                    {
+                      if (first[j] == int(k)) continue;
+                      const Point<3> & q = point(j);
+                      if (fabs(q(0)-p(0)) <= 2*tol && fabs(q(1)-p(1)) <= 2*tol &&
+                          fabs(q(2)-p(2)) <= 2*tol)
+                        close = true;
+                    }
+          }
+      });
+    return !close;
+  }
+}
 
 
 void STLTopology :: InitSTLGeometry(const NgArray<STLReadTriangle> & readtrigs)
 {
+  static Timer t("STLTopology::InitSTLGeometry"); RegionTimer reg(t);
   // const double geometry_tol_fact = 1E6; 
   // distances lower than max_box_size/tol are ignored
 
@@ -498,47 +816,19 @@ void STLTopology :: InitSTLGeometry(const NgArray<STLReadTriangle> & readtrigs)
   Box<3> bb = boundingbox;
   bb.Increase (1);
 
-  pointtree = new Point3dTree (bb.PMin(), bb.PMax());
-
-  NgArray<int> pintersect;
+  delete pointtree;
+  pointtree = nullptr;
 
   pointtol = boundingbox.Diam() * stldoctor.geom_tol_fact;
   PrintMessage(5,"point tolerance = ", pointtol);
   PrintMessageCR(5,"identify points ...");  
 
-  for(int i = 0; i < readtrigs.Size(); i++)
+  auto add_triangle = [&] (const STLReadTriangle & t, STLPointId * pnums)
     {
-      const STLReadTriangle & t = readtrigs[i];
-
       STLTriangle st;
       st.SetNormal (t.Normal());
-
       for (int k = 0; k < 3; k++)
-	{
-	  Point<3> p = t[k];
-
-	  Point<3> pmin = p - Vec<3> (pointtol, pointtol, pointtol);
-	  Point<3> pmax = p + Vec<3> (pointtol, pointtol, pointtol);
-	  
-	  pointtree->GetIntersecting (pmin, pmax, pintersect);
-	  
-	  if (pintersect.Size() > 1)
-            PrintError("too many close points");
-	  int foundpos = -1;
-	  if (pintersect.Size())
-	    foundpos = pintersect[0];
-	  
-	  if (foundpos == -1)
-	    {
-	      foundpos = AddPoint(p);
-	      pointtree->Insert (p, foundpos);
-	    }
-          if (Dist(p, points[foundpos]) > 1e-10)
-            cout << "identify close points: " << p << " " << points[foundpos]
-                 << ", dist = " << Dist(p, points[foundpos])
-                 << endl;
-	  st[k] = foundpos;
-	}
+        st[k] = pnums[k];
 
       if ( (st[0] == st[1]) ||
 	   (st[0] == st[2]) || 
@@ -550,8 +840,63 @@ void STLTopology :: InitSTLGeometry(const NgArray<STLReadTriangle> & readtrigs)
 	{
 	  AddTriangle(st);
 	}
-      
-    } 
+    };
+
+  Array<int> first;
+  if (IdentifyEqualPoints (readtrigs, boundingbox, pointtol, first))
+    {
+      // same numbering as the incremental point tree below:
+      // points are numbered in the order of their first appearance
+      Array<STLPointId> pnums(first.Size());
+      points.SetAllocSize (first.Size());
+      for (size_t k = 0; k < first.Size(); k++)
+        pnums[k] = (first[k] == int(k)) ? STLPointId(AddPoint(readtrigs[k/3][k%3]))
+          : pnums[first[k]];
+
+      trias.SetAllocSize (readtrigs.Size());
+      for (int i = 0; i < readtrigs.Size(); i++)
+        add_triangle (readtrigs[i], &pnums[3*i]);
+    }
+  else
+    {
+      pointtree = new Point3dTree (bb.PMin(), bb.PMax());
+      NgArray<int> pintersect;
+
+      for(int i = 0; i < readtrigs.Size(); i++)
+        {
+          const STLReadTriangle & t = readtrigs[i];
+          STLPointId pnums[3];
+
+          for (int k = 0; k < 3; k++)
+            {
+              Point<3> p = t[k];
+
+              Point<3> pmin = p - Vec<3> (pointtol, pointtol, pointtol);
+              Point<3> pmax = p + Vec<3> (pointtol, pointtol, pointtol);
+	  
+              pointtree->GetIntersecting (pmin, pmax, pintersect);
+	  
+              if (pintersect.Size() > 1)
+                PrintError("too many close points");
+              int foundpos = -1;
+              if (pintersect.Size())
+                foundpos = pintersect[0];
+	  
+              if (foundpos == -1)
+                {
+                  foundpos = AddPoint(p);
+                  pointtree->Insert (p, foundpos);
+                }
+              if (Dist(p, points[foundpos]) > 1e-10)
+                cout << "identify close points: " << p << " " << points[foundpos]
+                     << ", dist = " << Dist(p, points[foundpos])
+                     << endl;
+              pnums[k] = foundpos;
+            }
+
+          add_triangle (t, pnums);
+        }
+    }
   PrintMessage(5,"identify points ... done");  
   FindNeighbourTrigs();
 }
@@ -566,6 +911,16 @@ int STLTopology :: GetPointNum (const Point<3> & p)
   
   NgArray<int> pintersect;
 
+  if (!pointtree)
+    {
+      // not needed for identifying the points in InitSTLGeometry
+      Box<3> bb = boundingbox;
+      bb.Increase (1);
+      pointtree = new Point3dTree (bb.PMin(), bb.PMax());
+      for (STLPointId pi = 1; pi <= GetNP(); pi++)
+        pointtree->Insert (points[pi], pi);
+    }
+
   pointtree->GetIntersecting (pmin, pmax, pintersect);
   if (pintersect.Size() == 1)
     return pintersect[0];
@@ -873,6 +1228,8 @@ void STLTopology :: FindNeighbourTrigs()
 	}
     }
 
+  trigtree.Build (*this);
+
   TopologyChanged();
 
   PopStatus();
@@ -902,6 +1259,18 @@ void STLTopology :: GetTrianglesInBox (/*
       box1.Increase (1e-4);
 
       btrias.SetSize(0);
+
+      if (!trigtree.Empty())
+        {
+          trigtree.ForEachInBox (box1, [&] (STLTrigId ti)
+                                 {
+                                   if (box1.Intersect (GetTriangle(ti).box))
+                                     btrias.Append (ti);
+                                 });
+          // same order as the linear search
+          QuickSort (FlatArray<int> (btrias.Size(), &btrias[0]));
+          return;
+        }
    
       int nt = GetNT();
       for (i = 1; i <= nt; i++)
@@ -916,6 +1285,85 @@ void STLTopology :: GetTrianglesInBox (/*
 
 
 
+void STLTriangleTree :: Build (const STLTopology & geom)
+{
+  static Timer t("STLTriangleTree::Build"); RegionTimer reg(t);
+
+  int nt = geom.GetNT();
+  Clear();
+  if (nt == 0) return;
+
+  // padded triangle boxes and centers
+  Array<Box<3>, STLTrigId> boxes(nt);
+  Array<Point<3>, STLTrigId> centers(nt);
+  ngcore::ParallelForRange (size_t(nt), [&] (auto myrange)
+    {
+      for (int i : myrange)
+        {
+          STLTrigId ti = i+1;
+          const STLTriangle & trig = geom.GetTriangle(ti);
+          Box<3> box (geom.GetPoint(trig[0]), geom.GetPoint(trig[1]), geom.GetPoint(trig[2]));
+          box.Add (trig.box.PMin());
+          box.Add (trig.box.PMax());
+          centers[ti] = box.Center();
+          box.Increase (1e-5 * box.Diam() + 1e-12);
+          boxes[ti] = box;
+        }
+    });
+
+  trigs.SetSize (nt);
+  for (int i = 0; i < nt; i++)
+    trigs[i] = i+1;
+
+  nodes.SetAllocSize (2*(nt/2)+1);
+  nodes.Append (Node { boxes[trigs[0]], 0, nt, -1 });
+
+  // top-down median splits along the longest extension of the centers
+  ArrayMem<int, 64> todo;
+  todo.Append (0);
+  while (todo.Size())
+    {
+      int nodenr = todo.Last();
+      todo.DeleteLast();
+      int first = nodes[nodenr].first;
+      int next = nodes[nodenr].next;
+
+      Box<3> box (boxes[trigs[first]]);
+      Box<3> cbox (centers[trigs[first]], centers[trigs[first]]);
+      for (int i = first+1; i < next; i++)
+        {
+          box.Add (boxes[trigs[i]].PMin());
+          box.Add (boxes[trigs[i]].PMax());
+          cbox.Add (centers[trigs[i]]);
+        }
+      nodes[nodenr].box = box;
+
+      if (next - first <= 4) continue;
+
+      Vec<3> ext = cbox.PMax() - cbox.PMin();
+      int dir = 0;
+      if (ext(1) > ext(dir)) dir = 1;
+      if (ext(2) > ext(dir)) dir = 2;
+
+      int mid = (first + next) / 2;
+      std::nth_element (&trigs[first], &trigs[mid], &trigs[0]+next,
+                        [&] (STLTrigId a, STLTrigId b)
+                        {
+                          if (centers[a](dir) == centers[b](dir)) return a < b;
+                          return centers[a](dir) < centers[b](dir);
+                        });
+
+      int child = nodes.Size();
+      nodes[nodenr].child = child;
+      nodes.Append (Node { box, first, mid, -1 });
+      nodes.Append (Node { box, mid, next, -1 });
+      todo.Append (child);
+      todo.Append (child+1);
+    }
+}
+
+
+
 void STLTopology :: AddTriangle(const STLTriangle& t)
 {
   trias.Append(t);
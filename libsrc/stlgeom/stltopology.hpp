@@ -17,6 +17,7 @@
 namespace netgen {
 
 class STLGeometry;
+class STLTopology;
 
   // #define STLBASE 1
 
@@ -277,6 +278,153 @@ ostream& operator<<(ostream& os, const STLTriangle& t);
 
 
 
+/*
+  Bounding volume hierarchy over all triangles of an STL geometry.
+  The tree is built in one go and not modified afterwards, all queries
+  are const and can be used from several threads at the same time.
+  Triangle boxes are slightly enlarged, such that the line query
+  finds all triangles hit by STLTriangle::ProjectInPlain with a small
+  negative barycentric tolerance.
+*/
+class STLTriangleTree
+{
+  struct Node
+  {
+    Box<3> box;
+    int first, next;  // range in trigs
+    int child;        // children are child and child+1, -1 for leaves
+  };
+  Array<Node> nodes;
+  Array<STLTrigId> trigs;
+
+public:
+  void Build (const STLTopology & geom);
+  void Clear () { nodes.SetSize0(); trigs.SetSize0(); }
+  bool Empty () const { return nodes.Size() == 0; }
+
+  // calls func(trig) for triangles which may intersect the box
+  template <typename TFunc>
+  void ForEachInBox (const Box<3> & box, TFunc func) const
+  {
+    if (Empty()) return;
+    ArrayMem<int, 64> stack;
+    stack.Append(0);
+    while (stack.Size())
+      {
+        const Node & node = nodes[stack.Last()];
+        stack.DeleteLast();
+        if (!node.box.Intersect (box)) continue;
+        if (node.child == -1)
+          for (int i = node.first; i < node.next; i++)
+            func (trigs[i]);
+        else
+          {
+            stack.Append (node.child);
+            stack.Append (node.child+1);
+          }
+      }
+  }
+
+  // calls func(trig) for triangles which may be hit by the line p + t*dir
+  template <typename TFunc>
+  void ForEachOnLine (const Point<3> & p, const Vec<3> & dir, TFunc func) const
+  {
+    if (Empty()) return;
+    ArrayMem<int, 64> stack;
+    stack.Append(0);
+    while (stack.Size())
+      {
+        const Node & node = nodes[stack.Last()];
+        stack.DeleteLast();
+        if (!LineHitsBox (node.box, p, dir)) continue;
+        if (node.child == -1)
+          for (int i = node.first; i < node.next; i++)
+            func (trigs[i]);
+        else
+          {
+            stack.Append (node.child);
+            stack.Append (node.child+1);
+          }
+      }
+  }
+
+  /*
+    Finds the triangle with minimal dist(trig), where dist is a distance
+    from p not smaller than the distance of the triangle box from p
+    (return 1e99 to skip a triangle). Ties are resolved by the smaller
+    triangle number. Returns 0 if no triangle is accepted.
+  */
+  template <typename TFunc>
+  STLTrigId FindNearest (const Point<3> & p, TFunc dist) const
+  {
+    STLTrigId best = 0;
+    double bestdist = 1e99;
+    if (Empty()) return best;
+    ArrayMem<int, 64> stack;
+    stack.Append(0);
+    while (stack.Size())
+      {
+        const Node & node = nodes[stack.Last()];
+        stack.DeleteLast();
+        if (BoxDist (node.box, p) > bestdist) continue;
+        if (node.child == -1)
+          for (int i = node.first; i < node.next; i++)
+            {
+              double d = dist (trigs[i]);
+              if (d < bestdist || (d == bestdist && d < 1e99 && trigs[i] < best))
+                {
+                  bestdist = d;
+                  best = trigs[i];
+                }
+            }
+        else
+          {
+            // visit the closer child first
+            int c0 = node.child, c1 = node.child+1;
+            if (BoxDist (nodes[c0].box, p) < BoxDist (nodes[c1].box, p))
+              swap (c0, c1);
+            stack.Append (c0);
+            stack.Append (c1);
+          }
+      }
+    return best;
+  }
+
+private:
+  static bool LineHitsBox (const Box<3> & box, const Point<3> & p, const Vec<3> & dir)
+  {
+    double tmin = -1e99, tmax = 1e99;
+    for (int j = 0; j < 3; j++)
+      {
+        if (dir(j) == 0)
+          {
+            if (p(j) < box.PMin()(j) || p(j) > box.PMax()(j)) return false;
+            continue;
+          }
+        double t1 = (box.PMin()(j) - p(j)) / dir(j);
+        double t2 = (box.PMax()(j) - p(j)) / dir(j);
+        if (t1 > t2) swap (t1, t2);
+        tmin = max2 (tmin, t1);
+        tmax = min2 (tmax, t2);
+        if (tmin > tmax) return false;
+      }
+    return true;
+  }
+
+  static double BoxDist (const Box<3> & box, const Point<3> & p)
+  {
+    double sum = 0;
+    for (int j = 0; j < 3; j++)
+      {
+        double d = max3 (box.PMin()(j) - p(j), 0.0, p(j) - box.PMax()(j));
+        sum += d*d;
+      }
+    return sqrt (sum);
+  }
+};
+
+
+
 
 
 
@@ -300,6 +448,8 @@ protected:
 
   BoxTree<3> * searchtree; // ADT
   Point3dTree * pointtree;
+  // static triangle hierarchy, rebuilt with the topology tables
+  STLTriangleTree trigtree;
 
   Box<3> boundingbox;
   double pointtol;
@@ -321,6 +471,10 @@ public:
   static STLGeometry * LoadNaomi (istream & ist);
   DLL_HEADER static STLGeometry * Load (istream & ist, bool surface=false);
   static STLGeometry * LoadBinary (istream & ist);
+  // token by token parser for ASCII files the parallel parser does not accept
+  static void LoadAsciiSequential (const string & data,
+                                   NgArray<STLReadTriangle> & readtrigs,
+                                   bool & badnormals);
 
   void Save (const filesystem::path & filename) const;
   void SaveBinary (const filesystem::path & filename, const char* aname) const;
@@ -346,13 +500,14 @@ public:
   
   void GetTrianglesInBox (const Box<3> & box,
 			  NgArray<int> & trias) const;
+  const STLTriangleTree & GetTriangleTree () const { return trigtree; }
 
 
   int GetNP() const { return points.Size(); }
   int AddPoint(const Point<3> & p) { points.Append(p); return points.Size(); }
   const Point<3> & GetPoint(STLPointId nr) const { return points[nr]; } // .Get(nr); }
   int GetPointNum (const Point<3> & p);
-  void SetPoint(STLPointId nr, const Point<3> & p) { points[nr] = p; } // { points.Elem(nr) = p; }
+  void SetPoint(STLPointId nr, const Point<3> & p) { points[nr] = p; trigtree.Clear(); } // { points.Elem(nr) = p; }
   auto & GetPoints() const { return points; }
 
   const Point<3> & operator[] (STLPointId i) const { return points[i]; }
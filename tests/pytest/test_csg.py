@@ -22,6 +22,30 @@ def create_2_polyhedra():
 def test_2_polyhedra():
     create_2_polyhedra()
 
+def test_parallel_volume_subregions():
+    import pytest
+    from pyngcore import TaskManager
+    geo = CSGeometry()
+    geo.Add(OrthoBrick(Pnt(0,0,0), Pnt(4,1,1)))
+    mesh = geo.GenerateMesh(maxh=0.2, delaunay=False, parallel_meshing=False)
+    with TaskManager():
+        mesh_par = geo.GenerateMesh(maxh=0.2, delaunay=False, parallel_volume_subregions=4)
+    assert len(mesh_par.Elements3D()) == pytest.approx(len(mesh.Elements3D()), rel=0.1)
+
+def test_parallel_delaunay():
+    import pytest
+    from pyngcore import TaskManager
+    geo = CSGeometry()
+    geo.Add(Sphere(Pnt(0,0,0), 1) - OrthoBrick(Pnt(0,0,0), Pnt(2,2,2)))
+    mesh = geo.GenerateMesh(maxh=0.1, parallel_meshing=False)
+    mesh_batched = geo.GenerateMesh(maxh=0.1, parallel_delaunay=True)
+    with TaskManager():
+        mesh_par = geo.GenerateMesh(maxh=0.1, parallel_delaunay=True)
+    # batches do not depend on the number of threads
+    assert len(mesh_par.Points()) == len(mesh_batched.Points())
+    assert [el.vertices for el in mesh_par.Elements3D()] == [el.vertices for el in mesh_batched.Elements3D()]
+    assert len(mesh_par.Elements3D()) == pytest.approx(len(mesh.Elements3D()), rel=0.1)
+
 
 if __name__ == "__main__":
     from ngsolve import Mesh, Draw
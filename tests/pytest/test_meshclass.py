@@ -63,3 +63,25 @@ def test_copy_mesh():
         for dim in range(1, mesh.dim + 1):
             assert copy.GetRegionNames(dim) == mesh.GetRegionNames(dim)
         assert copy.GetIdentifications() == mesh.GetIdentifications()
+
+
+def test_elements_of_points(unit_mesh_3d):
+    np = pytest.importorskip("numpy")
+    mesh = unit_mesh_3d
+    rng = np.random.default_rng(42)
+    pts = rng.random((1000, 3))
+    pts[-1] = (2, 2, 2)
+    with pyngcore.TaskManager():
+        els, lami = mesh.GetElementsOfPoints(pts)
+    assert els.shape == (1000,)
+    assert lami.shape == (1000, 3)
+    assert els[-1] == -1
+    assert (els[:-1] >= 0).all()
+    # reconstruct points from vertices and barycentric coordinates
+    vertices = np.array([p.p for p in mesh.Points()])
+    elements = list(mesh.Elements3D())
+    for i in range(0, 999, 37):
+        verts = [v.nr-1 for v in elements[els[i]].vertices]
+        lam = list(lami[i]) + [1-sum(lami[i])]
+        p = sum(l*vertices[v] for l, v in zip(lam, verts))
+        assert np.allclose(p, pts[i])
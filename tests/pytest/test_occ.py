@@ -53,3 +53,13 @@ def test_internal_face():
     mesh = geo.GenerateMesh(maxh=0.5)
     assert any(mesh.Elements2D().NumPy()['index'] == 8)
 
+
+def test_parallel_surface_meshing():
+    occ = pytest.importorskip("netgen.occ")
+    box = occ.Box(occ.Pnt(0,0,0), occ.Pnt(1,1,1))
+    cyl = occ.Cylinder(occ.Pnt(1,0.5,0.5), occ.X, r=0.3, h=0.5)
+    geo = occ.OCCGeometry(box+cyl)
+    m_serial = geo.GenerateMesh(maxh=0.2, perfstepsend=4)
+    m_parallel = geo.GenerateMesh(maxh=0.2, perfstepsend=4, parallel_surface_meshing=True)
+    assert len(m_parallel.Elements2D()) > 0
+    assert len(m_parallel.Points()) == approx(len(m_serial.Points()), rel=0.1)
@@ -1,4 +1,5 @@
 
+import pytest
 from netgen.csg import *
 from netgen import meshing
 import filecmp
@@ -50,3 +51,52 @@ def test_BBNDsave():
     print(*l)
     assert len(l)==0
 
+
+def test_binarysave():
+    mesh = CreateGeo().GenerateMesh(maxh=0.4)
+    mesh.SetGeometry(None)
+    mesh.Save("test.vol")
+    mesh.Save("test.vol.ngb")
+    mesh2 = meshing.Mesh()
+    mesh2.Load("test.vol.ngb")
+    assert len(mesh2.Points()) == len(mesh.Points())
+    assert len(mesh2.Elements2D()) == len(mesh.Elements2D())
+    assert len(mesh2.Elements3D()) == len(mesh.Elements3D())
+    mesh2.Save("test2.vol")
+    assert filecmp.cmp("test.vol", "test2.vol", shallow=False)
+
+def test_gzipsave():
+    import gzip
+    from pyngcore import TaskManager
+    mesh = CreateGeo().GenerateMesh(maxh=0.4)
+    mesh.SetGeometry(None)
+    mesh.Save("test.vol")
+    with TaskManager():
+        mesh.Save("test.vol.gz")
+        mesh2 = meshing.Mesh()
+        mesh2.Load("test.vol.gz")
+    mesh2.Save("test2.vol")
+    with open("test.vol", "rb") as f, gzip.open("test.vol.gz", "rb") as fgz:
+        assert f.read() == fgz.read()
+    assert filecmp.cmp("test.vol", "test2.vol", shallow=False)
+
+@pytest.mark.slow
+@pytest.mark.parametrize("filename", ["cubemcyl.geo", "manyholes.geo", "shaft.geo", "trafo.geo"])
+def test_loadbenchmark(filename):
+    import os, time
+    from pyngcore import TaskManager, SetNumThreads
+    path = os.path.join(os.path.dirname(os.path.realpath(__file__)), "..", "..", "tutorials", filename)
+    mesh = CSGeometry(path).GenerateMesh()
+    mesh.SetGeometry(None)
+    mesh.Save(filename+".vol")
+    timings = {}
+    for nthreads in [1, 4]:
+        SetNumThreads(nthreads)
+        mesh2 = meshing.Mesh()
+        start = time.time()
+        with TaskManager():
+            mesh2.Load(filename+".vol")
+        timings[nthreads] = time.time() - start
+        mesh2.Save(filename+"_loaded.vol")
+        assert filecmp.cmp(filename+".vol", filename+"_loaded.vol", shallow=False)
+    print(filename, "ne =", len(mesh.Elements3D()), "load time 1 / 4 threads:", timings[1], timings[4])
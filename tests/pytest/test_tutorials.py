@@ -133,6 +133,34 @@ def test_geoFiles(filename, mp, i, refdata):
     checkData(mesh, mp, ref[i])
 
 
+def test_stl_parallel_surface_meshing():
+    geo = stl.STLGeometry(os.path.join("..","..","tutorials","hinge.stl"))
+    mesh = geo.GenerateMesh(perfstepsend=4)
+    with TaskManager():
+        mesh_par = geo.GenerateMesh(perfstepsend=4, parallel_surface_meshing=True)
+    assert len(mesh_par.Elements2D()) > 0
+    assert len(mesh_par.Points()) == pytest.approx(len(mesh.Points()), rel=0.1)
+
+
+def test_csg_parallel_special_points():
+    geo = csg.CSGeometry(os.path.join("..","..","tutorials","manyholes.geo"))
+    mesh = geo.GenerateMesh(perfstepsend=2, parallel_meshing=False)
+    with TaskManager():
+        mesh_par = geo.GenerateMesh(perfstepsend=2)
+    assert [tuple(p) for p in mesh_par.Points()] == [tuple(p) for p in mesh.Points()]
+    assert len(mesh_par.Elements1D()) == len(mesh.Elements1D())
+
+
+def test_csg_parallel_edges():
+    geo = csg.CSGeometry(os.path.join("..","..","tutorials","shaft.geo"))
+    mesh = geo.GenerateMesh(perfstepsend=2, parallel_meshing=False)
+    with TaskManager():
+        mesh_par = geo.GenerateMesh(perfstepsend=2)
+    assert [tuple(p) for p in mesh_par.Points()] == [tuple(p) for p in mesh.Points()]
+    assert [tuple(s.vertices) for s in mesh_par.Elements1D()] == \
+        [tuple(s.vertices) for s in mesh.Elements1D()]
+
+
 def generateResultFile(output_file='results.json'):
     import time
     data = {}